@@ -42,6 +42,8 @@
 #include <utility>
 
 #include <ldb/bcast/broadcaster.hxx>
+#include <ldb/bcast/null_broadcast.hxx>
+#include <ldb/data/tuple_id.hxx>
 #include <ldb/lv/linda_tuple.hxx>
 
 namespace ldb {
@@ -85,6 +87,9 @@ namespace ldb {
         explicit(false) broadcast_awaitable(Impl value)
              : _impl(std::make_unique<awaitable_model<Impl>>(std::move(value))) { }
 
+        // nothing to wait for: saves an allocation on each operation of a store without peers
+        explicit(false) broadcast_awaitable(null_awaiter) noexcept { }
+
         broadcast_awaitable(const broadcast_awaitable& other) = delete;
         broadcast_awaitable&
         operator=(const broadcast_awaitable& other) = delete;
@@ -104,9 +109,9 @@ namespace ldb {
     class broadcast final {
         struct broadcast_concept {
             virtual broadcast_awaitable
-            do_broadcast_insert(const lv::linda_tuple& tuple) = 0;
+            do_broadcast_insert(data::tuple_id id, const lv::linda_tuple& tuple) = 0;
             virtual broadcast_awaitable
-            do_broadcast_delete(const lv::linda_tuple& tuple) = 0;
+            do_broadcast_delete(data::tuple_id id) = 0;
 
             virtual ~broadcast_concept() = default;
         };
@@ -121,12 +126,12 @@ namespace ldb {
                  : bcast(std::forward<T>(init)) { }
 
             broadcast_awaitable
-            do_broadcast_insert(const lv::linda_tuple& tuple) override {
-                return broadcast_insert(bcast, tuple);
+            do_broadcast_insert(data::tuple_id id, const lv::linda_tuple& tuple) override {
+                return broadcast_insert(bcast, id, tuple);
             }
             broadcast_awaitable
-            do_broadcast_delete(const lv::linda_tuple& tuple) override {
-                return broadcast_delete(bcast, tuple);
+            do_broadcast_delete(data::tuple_id id) override {
+                return broadcast_delete(bcast, id);
             }
 
             impl_type bcast;
@@ -136,16 +141,17 @@ namespace ldb {
 
         friend broadcast_awaitable
         broadcast_insert(const broadcast& bcast,
+                         data::tuple_id id,
                          const lv::linda_tuple& tuple) {
             if (!bcast._impl) return {};
-            return bcast._impl->do_broadcast_insert(tuple);
+            return bcast._impl->do_broadcast_insert(id, tuple);
         }
 
         friend broadcast_awaitable
         broadcast_delete(const broadcast& bcast,
-                         const lv::linda_tuple& tuple) {
+                         data::tuple_id id) {
             if (!bcast._impl) return {};
-            return bcast._impl->do_broadcast_delete(tuple);
+            return bcast._impl->do_broadcast_delete(id);
         }
 
     public:
@@ -37,6 +37,8 @@
 #define LINDADB_BROADCASTER_HXX
 
 #include <concepts>
+
+#include <ldb/data/tuple_id.hxx>
 #include <ldb/lv/linda_tuple.hxx>
 
 namespace ldb {
@@ -49,8 +51,8 @@ namespace ldb {
     concept broadcaster = requires(Broadcast bcast) {
         typename Broadcast::await_type;
 
-        { broadcast_insert(bcast, lv::linda_tuple{}) } -> awaitable;
-        { broadcast_delete(bcast, lv::linda_tuple{}) } -> awaitable;
+        { broadcast_insert(bcast, data::tuple_id{}, lv::linda_tuple{}) } -> awaitable;
+        { broadcast_delete(bcast, data::tuple_id{}) } -> awaitable;
     } && awaitable<typename Broadcast::await_type>;
 }
 
@@ -39,6 +39,7 @@
 #include <tuple>
 
 #include <ldb/bcast/broadcaster.hxx>
+#include <ldb/data/tuple_id.hxx>
 #include <ldb/lv/linda_tuple.hxx>
 
 namespace ldb {
@@ -55,13 +56,14 @@ namespace ldb {
     };
 
     inline null_awaiter
-    broadcast_insert(null_broadcast, const lv::linda_tuple& tuple) {
+    broadcast_insert(null_broadcast, data::tuple_id id, const lv::linda_tuple& tuple) {
+        std::ignore = id;
         std::ignore = tuple;
         return null_awaiter{};
     }
     inline null_awaiter
-    broadcast_delete(null_broadcast, const lv::linda_tuple& tuple) {
-        std::ignore = tuple;
+    broadcast_delete(null_broadcast, data::tuple_id id) {
+        std::ignore = id;
         return null_awaiter{};
     }
 
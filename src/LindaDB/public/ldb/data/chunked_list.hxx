@@ -65,7 +65,9 @@
 #include <bit>
 #include <bitset>
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <memory>
@@ -349,6 +351,15 @@ namespace ldb::data {
                 }
             }
 
+            /// Calls fn with the values of the chunk and the mask of the valid ones, under one lock.
+            template<class Fn>
+            decltype(auto)
+            with_values(Fn&& fn) const {
+                std::shared_lock<std::shared_mutex> lck(_data_mtx);
+                return std::forward<Fn>(fn)(std::bit_cast<const_pointer>(_data.data()),
+                                            static_cast<std::uint64_t>(_valids.load(std::memory_order::acquire)));
+            }
+
             [[nodiscard]] constexpr bool
             valid_at_index(size_type idx) const noexcept {
                 return (_valids.load(std::memory_order::acquire) & (1U << idx)) != 0U;
@@ -476,6 +487,11 @@ namespace ldb::data {
 
             constexpr iterator_impl() = default;
 
+            [[nodiscard]] std::size_t
+            hash() const noexcept {
+                return std::hash<const void*>{}(_chunk) ^ (std::hash<size_type>{}(_index) << 1);
+            }
+
             void
             swap(iterator_impl& other) noexcept {
                 using std::swap;
@@ -601,11 +617,8 @@ namespace ldb::data {
             requires(std::copyable<T>)
         {
             std::scoped_lock<std::shared_mutex> lck(_mtx);
-            auto last = end_unguarded();
-            auto found = std::ranges::find_if(begin_unguarded(), last, [query = std::forward<Q>(query)](const auto& stored) {
-                return stored == query;
-            });
-            if (found == last) return std::nullopt;
+            auto found = find_unguarded(query);
+            if (found == end_unguarded()) return std::nullopt;
 
             auto ret = std::optional{*found};
             erase_unguarded(found);
@@ -618,15 +631,51 @@ namespace ldb::data {
             requires(std::copyable<T>)
         {
             std::scoped_lock<std::shared_mutex> lck(_mtx);
-            auto last = end_unguarded();
-            auto found = std::ranges::find_if(begin_unguarded(), last, [query = std::forward<Q>(query)](const auto& stored) {
-                return stored == query;
-            });
-            if (found == last) return std::nullopt;
+            auto found = find_unguarded(query);
+            if (found == end_unguarded()) return std::nullopt;
             return std::optional{*found};
         }
 
+        template<class Q>
+        std::optional<iterator>
+        locked_find_iterator(Q&& query) const {
+            std::scoped_lock<std::shared_mutex> lck(_mtx);
+            auto found = find_unguarded(query);
+            if (found == end_unguarded()) return std::nullopt;
+            return found;
+        }
+
     private:
+        template<class Q>
+        constexpr const static bool matches_blocks = ChunkSize <= 64
+                                                     && requires(const Q& query, const_pointer values, std::uint64_t mask) {
+                                                            { query.match_block(values, mask) } -> std::convertible_to<std::uint64_t>;
+                                                        };
+
+        /// Finds the first value equal to query. Queries that can match a
+        /// whole chunk at once are asked once per chunk, not once per value.
+        template<class Q>
+        iterator
+        find_unguarded(const Q& query) const {
+            if constexpr (matches_blocks<Q>) {
+                for (const auto& chunk : _chunks) {
+                    auto matches = chunk->with_values([&query](const_pointer values, std::uint64_t valids) {
+                        return static_cast<std::uint64_t>(query.match_block(values, valids));
+                    });
+                    for (; matches != 0; matches &= matches - 1) {
+                        const auto idx = static_cast<size_type>(std::countr_zero(matches));
+                        if ((*chunk)[idx] == query) return iterator(chunk.get(), idx);
+                    }
+                }
+                return end_unguarded();
+            }
+            else {
+                return std::ranges::find_if(begin_unguarded(), end_unguarded(), [&query](const auto& stored) {
+                    return stored == query;
+                });
+            }
+        }
+
         iterator
         begin_unguarded() const {
             if (_chunks.size() == 0) return iterator();
@@ -0,0 +1,106 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/public/ldb/data/mpsc_queue --
+ *   An unbounded lock-free queue from any number of producer threads to one
+ *   consumer thread. It is a linked list of nodes: producers swap themselves
+ *   in at the head and then link the previous head to their node, the
+ *   consumer follows the links from the tail.
+ *
+ *  tail              head
+ *  [_] -> [A] -> [B] -> [C]
+ *
+ *  The node at the tail has already been consumed: popping moves the value
+ *  out of the next node and frees the old tail. A producer between its swap
+ *  and its link makes the queue look shorter for a moment, which only delays
+ *  the consumer until its next try.
+ */
+#ifndef LINDADB_MPSC_QUEUE_HXX
+#define LINDADB_MPSC_QUEUE_HXX
+
+#include <atomic>
+#include <concepts>
+#include <optional>
+#include <utility>
+
+namespace ldb::data {
+    template<std::movable T>
+    class mpsc_queue {
+        struct node {
+            std::atomic<node*> next{nullptr};
+            std::optional<T> value{};
+        };
+
+    public:
+        mpsc_queue()
+             : _head(new node),
+               _tail(_head.load(std::memory_order_relaxed)) { }
+
+        mpsc_queue(const mpsc_queue& cp) = delete;
+        mpsc_queue&
+        operator=(const mpsc_queue& cp) = delete;
+
+        ~mpsc_queue() noexcept {
+            for (auto* it = _tail; it != nullptr;) {
+                delete std::exchange(it, it->next.load(std::memory_order_relaxed));
+            }
+        }
+
+        /// Any thread: adds value to the queue.
+        void
+        push(T value) {
+            auto* pushed = new node{nullptr, std::move(value)};
+            auto* prev = _head.exchange(pushed, std::memory_order_acq_rel);
+            prev->next.store(pushed, std::memory_order_release);
+        }
+
+        /// Consumer only: takes the oldest value, if there is one.
+        std::optional<T>
+        try_pop() {
+            auto* next = _tail->next.load(std::memory_order_acquire);
+            if (next == nullptr) return std::nullopt;
+
+            auto value = std::exchange(next->value, std::nullopt);
+            delete std::exchange(_tail, next);
+            return value;
+        }
+
+    private:
+        // producers only touch the head, the consumer only the tail
+        constexpr const static std::size_t cache_line_size = 64;
+
+        alignas(cache_line_size) std::atomic<node*> _head;
+        alignas(cache_line_size) node* _tail;
+    };
+}
+
+#endif
@@ -0,0 +1,301 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/public/ldb/data/small_vector --
+ *   A vector-like container that stores its first few elements inline, and only
+ *   allocates memory once it grows over that inline capacity.
+ *   Memory layout looks like the following, where letters are the stored values.
+ *
+ *  [size, cap = N, [A, B, _]]               <- inline
+ *  [size, cap > N, [*      ]]               <- spilled
+ *                   \
+ *                    [A, B, C, D, E, _, _]
+ *
+ *  Once spilled, the heap buffer is kept until the object dies, even if the size
+ *  decreases again, so that keys with many duplicates do not thrash the allocator.
+ */
+#ifndef LINDADB_SMALL_VECTOR_HXX
+#define LINDADB_SMALL_VECTOR_HXX
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <ldb/common.hxx>
+
+namespace ldb::data {
+    template<class T, std::size_t N>
+    struct small_vector {
+        static_assert(N > 0, "small_vector requires a nonzero inline capacity");
+
+        using value_type = T;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        small_vector() noexcept { }
+
+        small_vector(std::initializer_list<T> init) {
+            append(init.begin(), init.end());
+        }
+
+        template<std::input_iterator It, std::sentinel_for<It> S>
+        small_vector(It first, S last) {
+            append(first, last);
+        }
+
+        small_vector(const small_vector& cp) {
+            append(cp.begin(), cp.end());
+        }
+
+        small_vector(small_vector&& mv) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            steal(mv);
+        }
+
+        small_vector&
+        operator=(const small_vector& cp) {
+            if (this == &cp) return *this;
+            clear();
+            append(cp.begin(), cp.end());
+            return *this;
+        }
+
+        small_vector&
+        operator=(small_vector&& mv) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            if (this == &mv) return *this;
+            release();
+            steal(mv);
+            return *this;
+        }
+
+        ~small_vector() noexcept {
+            release();
+        }
+
+        [[nodiscard]] size_type
+        size() const noexcept { return _size; }
+
+        [[nodiscard]] bool
+        empty() const noexcept { return _size == 0; }
+
+        [[nodiscard]] size_type
+        capacity() const noexcept { return _capacity; }
+
+        [[nodiscard]] bool
+        is_inline() const noexcept { return _capacity == N; }
+
+        [[nodiscard]] pointer
+        data() noexcept {
+            if (is_inline()) return std::launder(reinterpret_cast<pointer>(_inline));
+            return _heap;
+        }
+
+        [[nodiscard]] const_pointer
+        data() const noexcept {
+            if (is_inline()) return std::launder(reinterpret_cast<const_pointer>(_inline));
+            return _heap;
+        }
+
+        [[nodiscard]] iterator
+        begin() noexcept { return data(); }
+        [[nodiscard]] const_iterator
+        begin() const noexcept { return data(); }
+        [[nodiscard]] const_iterator
+        cbegin() const noexcept { return data(); }
+
+        [[nodiscard]] iterator
+        end() noexcept { return data() + _size; }
+        [[nodiscard]] const_iterator
+        end() const noexcept { return data() + _size; }
+        [[nodiscard]] const_iterator
+        cend() const noexcept { return data() + _size; }
+
+        [[nodiscard]] reference
+        operator[](size_type idx) noexcept {
+            assert_that(idx < _size);
+            return data()[idx];
+        }
+
+        [[nodiscard]] const_reference
+        operator[](size_type idx) const noexcept {
+            assert_that(idx < _size);
+            return data()[idx];
+        }
+
+        [[nodiscard]] reference
+        back() noexcept {
+            assert_that(_size > 0);
+            return data()[_size - 1];
+        }
+
+        [[nodiscard]] const_reference
+        back() const noexcept {
+            assert_that(_size > 0);
+            return data()[_size - 1];
+        }
+
+        void
+        reserve(size_type new_capacity) {
+            if (new_capacity <= _capacity) return;
+            reallocate(new_capacity, [](pointer) { return size_type{0}; });
+        }
+
+        template<class... Args>
+        reference
+        emplace_back(Args&&... args) {
+            if (_size == _capacity) {
+                // construct the new element first: args may refer into our own buffer
+                reallocate(_capacity * 2, [this, &args...](pointer new_data) {
+                    std::construct_at(new_data + _size, std::forward<Args>(args)...);
+                    return size_type{1};
+                });
+            }
+            else {
+                std::construct_at(data() + _size, std::forward<Args>(args)...);
+            }
+            return data()[_size++];
+        }
+
+        void
+        push_back(const T& value) { emplace_back(value); }
+
+        void
+        push_back(T&& value) { emplace_back(std::move(value)); }
+
+        template<std::input_iterator It, std::sentinel_for<It> S>
+        void
+        append(It first, S last) {
+            if constexpr (std::sized_sentinel_for<S, It>) {
+                const auto needed = _size + static_cast<size_type>(std::distance(first, last));
+                if (needed > _capacity) reserve(std::max(needed, _capacity * 2));
+            }
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+
+        void
+        pop_back() noexcept {
+            assert_that(_size > 0);
+            std::destroy_at(data() + --_size);
+        }
+
+        iterator
+        erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
+            assert_that(begin() <= pos && pos < end());
+            const auto it = begin() + (pos - cbegin());
+            std::move(it + 1, end(), it);
+            std::destroy_at(data() + --_size);
+            return it;
+        }
+
+        void
+        clear() noexcept {
+            std::destroy_n(data(), _size);
+            _size = 0;
+        }
+
+    private:
+        template<class Fn>
+        void
+        reallocate(size_type new_capacity, Fn&& construct_new) {
+            std::allocator<T> alloc;
+            const auto new_data = alloc.allocate(new_capacity);
+            size_type built = 0;
+            try {
+                // construct_new returns how many elements it built past _size
+                built = std::forward<Fn>(construct_new)(new_data);
+                // like std::vector, only move if that cannot throw (or there is no copy),
+                // so the old elements are intact if relocating fails halfway
+                if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+                    std::uninitialized_move_n(data(), _size, new_data);
+                }
+                else {
+                    std::uninitialized_copy_n(data(), _size, new_data);
+                }
+            } catch (...) {
+                // the uninitialized algorithms already destroyed their partial output
+                std::destroy_n(new_data + _size, built);
+                alloc.deallocate(new_data, new_capacity);
+                throw;
+            }
+            std::destroy_n(data(), _size);
+            if (!is_inline()) alloc.deallocate(_heap, _capacity);
+            _heap = new_data;
+            _capacity = new_capacity;
+        }
+
+        void
+        release() noexcept {
+            clear();
+            if (!is_inline()) std::allocator<T>{}.deallocate(_heap, _capacity);
+            _capacity = N;
+        }
+
+        void
+        steal(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            if (other.is_inline()) {
+                std::uninitialized_move_n(other.data(), other._size, data());
+                _size = other._size;
+                other.clear();
+                return;
+            }
+            _heap = std::exchange(other._heap, nullptr);
+            _size = std::exchange(other._size, 0);
+            _capacity = std::exchange(other._capacity, N);
+        }
+
+        friend bool
+        operator==(const small_vector& lhs, const small_vector& rhs) {
+            return std::ranges::equal(lhs, rhs);
+        }
+
+        size_type _size{0};
+        size_type _capacity{N};
+        union {
+            pointer _heap;
+            alignas(T) std::byte _inline[sizeof(T) * N];
+        };
+    };
+}
+
+#endif
@@ -0,0 +1,141 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/public/ldb/data/spsc_queue --
+ *   A bounded lock-free queue between exactly one producer and one consumer
+ *   thread. The slots form a ring indexed by two ever-increasing counters:
+ *   the producer owns the tail, the consumer owns the head, and each only
+ *   reads the other's counter, so neither ever takes a lock.
+ *
+ *  [_, _, A, B, C, _, _, _]
+ *         ^head    ^tail
+ *
+ *  The blocking operations wait on the counter of the other side, so an
+ *  idle consumer sleeps instead of spinning.
+ */
+#ifndef LINDADB_SPSC_QUEUE_HXX
+#define LINDADB_SPSC_QUEUE_HXX
+
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ldb::data {
+    template<class T>
+        requires(std::default_initializable<T> && std::movable<T>)
+    class spsc_queue {
+    public:
+        /// Holds at least capacity elements: the capacity is rounded up to a power of two.
+        explicit spsc_queue(std::size_t capacity)
+             : _slots(std::bit_ceil(capacity < 1 ? std::size_t{1} : capacity)),
+               _mask(_slots.size() - 1) { }
+
+        spsc_queue(const spsc_queue& cp) = delete;
+        spsc_queue&
+        operator=(const spsc_queue& cp) = delete;
+
+        [[nodiscard]] std::size_t
+        capacity() const noexcept { return _slots.size(); }
+
+        /// Producer only: adds value unless the queue is full.
+        bool
+        try_push(T&& value) {
+            const auto tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _head.load(std::memory_order_acquire) == _slots.size()) return false;
+            publish(tail, std::move(value));
+            return true;
+        }
+
+        /// Producer only: adds value, waiting for room while the queue is full.
+        void
+        push(T value) {
+            const auto tail = _tail.load(std::memory_order_relaxed);
+            for (auto head = _head.load(std::memory_order_acquire);
+                 tail - head == _slots.size();
+                 head = _head.load(std::memory_order_acquire)) {
+                _head.wait(head, std::memory_order_acquire);
+            }
+            publish(tail, std::move(value));
+        }
+
+        /// Consumer only: takes the oldest value, if there is one.
+        std::optional<T>
+        try_pop() {
+            const auto head = _head.load(std::memory_order_relaxed);
+            if (_tail.load(std::memory_order_acquire) == head) return std::nullopt;
+            return consume(head);
+        }
+
+        /// Consumer only: takes the oldest value, waiting for one while the queue is empty.
+        T
+        pop() {
+            const auto head = _head.load(std::memory_order_relaxed);
+            for (auto tail = _tail.load(std::memory_order_acquire);
+                 tail == head;
+                 tail = _tail.load(std::memory_order_acquire)) {
+                _tail.wait(tail, std::memory_order_acquire);
+            }
+            return consume(head);
+        }
+
+    private:
+        void
+        publish(std::size_t tail, T&& value) {
+            _slots[tail & _mask] = std::move(value);
+            _tail.store(tail + 1, std::memory_order_release);
+            _tail.notify_one();
+        }
+
+        T
+        consume(std::size_t head) {
+            auto value = std::exchange(_slots[head & _mask], T{});
+            _head.store(head + 1, std::memory_order_release);
+            _head.notify_one();
+            return value;
+        }
+
+        // not hardware_destructive_interference_size: it would make the layout depend on compiler flags
+        constexpr const static std::size_t cache_line_size = 64;
+
+        std::vector<T> _slots;
+        std::size_t _mask;
+        // on lines of their own: the two threads write them all the time
+        alignas(cache_line_size) std::atomic<std::size_t> _head{0};
+        alignas(cache_line_size) std::atomic<std::size_t> _tail{0};
+    };
+}
+
+#endif
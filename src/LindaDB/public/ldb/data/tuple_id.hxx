@@ -0,0 +1,90 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/public/ldb/data/tuple_id --
+ *   The cluster-unique identity of a stored tuple: the rank of the node that
+ *   put it in the space and the sequence number of the insertion there.
+ *   Replicas refer to tuples by their ids, so removing one does not need the
+ *   tuple itself, and equal tuples are still told apart.
+ */
+#ifndef LINDADB_TUPLE_ID_HXX
+#define LINDADB_TUPLE_ID_HXX
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace ldb::data {
+    struct tuple_id {
+        std::uint32_t origin;
+        std::uint64_t sequence;
+
+        friend constexpr bool
+        operator==(const tuple_id& lhs, const tuple_id& rhs) noexcept = default;
+    };
+
+    /// The bytes of a tuple_id on the wire: without the padding of the struct.
+    constexpr const static std::size_t tuple_id_wire_size = sizeof(std::uint32_t) + sizeof(std::uint64_t);
+
+    /// Hands out the ids of the tuples inserted on one node.
+    struct tuple_id_source {
+        explicit tuple_id_source(std::uint32_t origin = 0) noexcept
+             : _origin(origin) { }
+
+        void
+        set_origin(std::uint32_t origin) noexcept { _origin = origin; }
+
+        [[nodiscard]] tuple_id
+        next() noexcept {
+            return {_origin, _next_sequence.fetch_add(1, std::memory_order_relaxed)};
+        }
+
+    private:
+        std::uint32_t _origin;
+        std::atomic<std::uint64_t> _next_sequence{0};
+    };
+}
+
+namespace std {
+    template<>
+    struct hash<ldb::data::tuple_id> {
+        std::size_t
+        operator()(const ldb::data::tuple_id& id) const noexcept {
+            // sequences of one origin are dense: spread them with a multiplicative hash
+            return static_cast<std::size_t>((id.sequence ^ (std::uint64_t{id.origin} << 48U))
+                                            * 0x9E37'79B9'7F4A'7C15ULL);
+        }
+    };
+}
+
+#endif
@@ -54,6 +54,17 @@ namespace ldb::index::tree {
         { value != query };
     };
 
+    /**
+     * An index lookup that identifies exactly one stored value, which it can
+     * expose. Payloads may use the exposed value to find the match directly
+     * instead of comparing against each of their values.
+     */
+    template<class Lookup, class Match>
+    concept handle_lookup = index_lookup<Lookup, Match>
+                            && requires(const Lookup& query) {
+                                   { query.value() } -> std::convertible_to<const Match&>;
+                               };
+
     template<class K>
     struct any_value_lookup {
         using key_type = K;
@@ -97,6 +108,9 @@ namespace ldb::index::tree {
         [[nodiscard]] const key_type&
         key() const noexcept { return _key; }
 
+        [[nodiscard]] const value_type&
+        value() const noexcept { return _value; }
+
     private:
         key_type _key;
         value_type _value;
@@ -108,10 +122,18 @@ namespace ldb::index::tree {
 
         friend constexpr bool
         operator==(const auto& a, const value_lookup& b) noexcept {
-            return std::is_eq(a <=> b);
+            // queries can tell a match faster than how they order against a value
+            if constexpr (requires { { a == b._value } -> std::convertible_to<bool>; }) {
+                return a == b._value;
+            }
+            else {
+                return std::is_eq(a <=> b);
+            }
         }
     };
     static_assert(index_lookup<value_lookup<int, int>, int>);
+    static_assert(handle_lookup<value_lookup<int, int>, int>);
+    static_assert(!handle_lookup<any_value_lookup<int>, int>);
 
     template<class K, class V>
     value_lookup(const K&, const V&) -> value_lookup<K, V>;
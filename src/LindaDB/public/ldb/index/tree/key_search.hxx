@@ -0,0 +1,274 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/public/ldb/index/tree/key_search --
+ *   Searching the sorted key arrays stored inside the index tree's nodes.
+ *   Integral keys are searched using SIMD compares when the target supports it,
+ *   and so are variant keys (like linda_value) while all keys of a node hold the
+ *   same integral alternative, through a packed copy of them kept by the node.
+ *   Everything else falls back to a binary search.
+ */
+#ifndef LINDADB_KEY_SEARCH_HXX
+#define LINDADB_KEY_SEARCH_HXX
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <variant>
+
+#if defined(__AVX2__)
+#  define LDB_KEY_SEARCH_AVX2 1
+#  include <immintrin.h>
+#elif defined(__SSE4_2__)
+#  define LDB_KEY_SEARCH_SSE42 1
+#  include <nmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define LDB_KEY_SEARCH_SSE2 1
+#  include <emmintrin.h>
+#endif
+
+namespace ldb::index::tree {
+    namespace meta {
+        template<class K, class Key>
+        concept simd_searchable_key = std::integral<K>
+                                      && !std::same_as<K, bool>
+                                      && std::same_as<K, std::remove_cvref_t<Key>>
+                                      && (sizeof(K) == 2 || sizeof(K) == 4 || sizeof(K) == 8);
+    }
+
+    namespace helper {
+        // unsigned keys are compared with signed instructions after flipping their
+        // top bit, which maps their order onto the order of the signed values
+        template<std::integral T>
+        constexpr const static auto sign_bias =
+               std::is_signed_v<T> ? std::make_unsigned_t<T>{0}
+                                   : static_cast<std::make_unsigned_t<T>>(std::make_unsigned_t<T>{1} << (sizeof(T) * 8 - 1));
+
+#if defined(LDB_KEY_SEARCH_AVX2) || defined(LDB_KEY_SEARCH_SSE42) || defined(LDB_KEY_SEARCH_SSE2)
+        // broadcasting the biased T{0} yields the bias vector itself
+        template<std::integral T>
+        [[nodiscard]] inline __m128i
+        broadcast_128(T val) noexcept {
+            const auto biased = static_cast<std::make_unsigned_t<T>>(val) ^ sign_bias<T>;
+            if constexpr (sizeof(T) == 2) return _mm_set1_epi16(static_cast<short>(biased));
+            if constexpr (sizeof(T) == 4) return _mm_set1_epi32(static_cast<int>(biased));
+            if constexpr (sizeof(T) == 8) return _mm_set1_epi64x(static_cast<long long>(biased));
+        }
+
+        /**
+         * Returns the bitmask of the lanes of the 16 bytes at keys which are
+         * less than the needle. Each lane of the key type yields sizeof(T) bits.
+         */
+        template<std::integral T>
+        [[nodiscard]] inline unsigned
+        less_mask_128(const T* keys, __m128i needle, __m128i bias) noexcept {
+            const auto loaded = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys)), bias);
+            if constexpr (sizeof(T) == 2) return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi16(needle, loaded)));
+            if constexpr (sizeof(T) == 4) return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi32(needle, loaded)));
+#  if defined(LDB_KEY_SEARCH_AVX2) || defined(LDB_KEY_SEARCH_SSE42)
+            if constexpr (sizeof(T) == 8) return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi64(needle, loaded)));
+#  endif
+        }
+#endif
+
+#if defined(LDB_KEY_SEARCH_AVX2)
+        template<std::integral T>
+        [[nodiscard]] inline unsigned
+        less_mask_256(const T* keys, __m256i needle, __m256i bias) noexcept {
+            const auto loaded = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys)), bias);
+            if constexpr (sizeof(T) == 2) return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpgt_epi16(needle, loaded)));
+            if constexpr (sizeof(T) == 4) return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpgt_epi32(needle, loaded)));
+            if constexpr (sizeof(T) == 8) return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpgt_epi64(needle, loaded)));
+        }
+#endif
+
+        /**
+         * Finds the lower bound of key in the sorted range of keys by counting the
+         * keys less than it, a vector-width at a time. As the keys are sorted, the
+         * lanes less than key form a prefix, so the first vector that is not
+         * entirely less contains the position we are looking for.
+         */
+        template<std::integral T>
+        [[nodiscard]] inline std::size_t
+        simd_lower_bound(const T* keys, std::size_t size, T key) noexcept {
+            std::size_t i = 0;
+#if defined(LDB_KEY_SEARCH_AVX2)
+            {
+                constexpr const auto lanes = 32 / sizeof(T);
+                const auto needle = _mm256_broadcastsi128_si256(broadcast_128(key));
+                const auto bias = _mm256_broadcastsi128_si256(broadcast_128(T{0}));
+                for (; i + lanes <= size; i += lanes) {
+                    const auto mask = less_mask_256(keys + i, needle, bias);
+                    if (mask != 0xFFFF'FFFFU) return i + static_cast<std::size_t>(std::countr_one(mask)) / sizeof(T);
+                }
+            }
+#endif
+#if defined(LDB_KEY_SEARCH_AVX2) || defined(LDB_KEY_SEARCH_SSE42) || defined(LDB_KEY_SEARCH_SSE2)
+#  if defined(LDB_KEY_SEARCH_SSE2)
+            if constexpr (sizeof(T) != 8)
+#  endif
+            {
+                constexpr const auto lanes = 16 / sizeof(T);
+                const auto needle = broadcast_128(key);
+                const auto bias = broadcast_128(T{0});
+                for (; i + lanes <= size; i += lanes) {
+                    const auto mask = less_mask_128(keys + i, needle, bias);
+                    if (mask != 0xFFFFU) return i + static_cast<std::size_t>(std::countr_one(mask)) / sizeof(T);
+                }
+            }
+#endif
+            while (i < size && keys[i] < key) ++i;
+            return i;
+        }
+    }
+
+    namespace helper {
+        // maps the values of any integral alternative onto int64 keeping their order
+        template<std::integral T>
+        [[nodiscard]] constexpr std::int64_t
+        pack_integral(T val) noexcept {
+            static_assert(sizeof(T) <= sizeof(std::int64_t));
+            if constexpr (std::is_signed_v<T> || sizeof(T) < sizeof(std::int64_t)) return static_cast<std::int64_t>(val);
+            else return static_cast<std::int64_t>(static_cast<std::uint64_t>(val) ^ sign_bias<std::uint64_t>);
+        }
+    }
+
+    /// A variant key as packed_keys search it: its alternative, and its value if that is integral.
+    struct packed_variant_key {
+        std::size_t alternative;
+        std::optional<std::int64_t> value;
+    };
+
+    namespace meta {
+        /// Lookup keys standing for a variant key K, like the matchers of a query, may pack themselves.
+        template<class Key, class K>
+        concept packable_lookup_key = requires(const Key& key) {
+            { key.template packed_key<K>() } -> std::same_as<packed_variant_key>;
+        };
+    }
+
+    /**
+     * The packed copy of the keys of a node, which only variant keys with an
+     * integral alternative have; for every other key type this is empty.
+     */
+    template<class K, std::size_t Clustering>
+    struct packed_keys {
+        constexpr void
+        repack(std::span<const K>) noexcept { }
+
+        template<class Key>
+        [[nodiscard]] constexpr std::optional<std::size_t>
+        lower_bound(const Key&, std::size_t) const noexcept { return std::nullopt; }
+    };
+
+    /**
+     * Variant keys order by their alternative first, then by value. While every
+     * key of the node holds the same integral alternative, their values are kept
+     * packed into int64s: a key of that alternative is then searched with integer
+     * compares, and any other one lands before or after all of them.
+     * The owner has to repack after each change of its keys.
+     */
+    template<std::size_t Clustering, class... Ts>
+        requires(std::integral<Ts> || ...)
+    struct packed_keys<std::variant<Ts...>, Clustering> {
+        using key_type = std::variant<Ts...>;
+
+        constexpr void
+        repack(std::span<const key_type> keys) noexcept {
+            _alternative = std::variant_npos;
+            if (keys.empty() || keys.front().valueless_by_exception()) return;
+            const auto alternative = keys.front().index();
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                if (keys[i].index() != alternative) return;
+                const auto packed = pack(keys[i]).value;
+                if (!packed) return;
+                _packed[i] = *packed;
+            }
+            _alternative = alternative;
+        }
+
+        /// The lower bound of key among the first size keys, if they are packed.
+        template<class Key>
+        [[nodiscard]] std::optional<std::size_t>
+        lower_bound(const Key& key, std::size_t size) const noexcept {
+            if (_alternative == std::variant_npos) return std::nullopt;
+            packed_variant_key packed{std::variant_npos, std::nullopt};
+            if constexpr (std::same_as<Key, key_type>) {
+                if (!key.valueless_by_exception()) packed = pack(key);
+            }
+            else if constexpr (meta::packable_lookup_key<Key, key_type>) {
+                packed = key.template packed_key<key_type>();
+            }
+            if (packed.alternative == std::variant_npos) return std::nullopt;
+            if (packed.alternative != _alternative) return packed.alternative < _alternative ? 0 : size;
+            return helper::simd_lower_bound(_packed.data(), size, *packed.value);
+        }
+
+        /// Packs a key which is not valueless.
+        [[nodiscard]] constexpr static packed_variant_key
+        pack(const key_type& key) noexcept {
+            return std::visit([&key](const auto& val) -> packed_variant_key {
+                using value_type = std::remove_cvref_t<decltype(val)>;
+                if constexpr (std::integral<value_type>) return {key.index(), helper::pack_integral(val)};
+                else return {key.index(), std::nullopt};
+            },
+                              key);
+        }
+
+    private:
+        std::size_t _alternative = std::variant_npos;
+        std::array<std::int64_t, Clustering> _packed{};
+    };
+
+    /**
+     * Returns the index of the first key in the sorted keys that is not less than
+     * key, or keys.size() if there is none.
+     */
+    template<class K, class Key>
+    [[nodiscard]] constexpr std::size_t
+    key_lower_bound(std::span<const K> keys, const Key& key) {
+        if constexpr (meta::simd_searchable_key<K, Key>) {
+            if (!std::is_constant_evaluated()) return helper::simd_lower_bound(keys.data(), keys.size(), key);
+        }
+        return static_cast<std::size_t>(std::distance(keys.begin(),
+                                                      std::lower_bound(keys.begin(), keys.end(), key)));
+    }
+}
+
+#endif
@@ -44,17 +44,62 @@
 #include <concepts>
 #include <cstdlib>
 #include <execution>
+#include <functional>
 #include <iterator>
+#include <memory>
 #include <span>
 #include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
-#include <vector>
+#include <variant>
 
 #include <ldb/common.hxx>
+#include <ldb/data/small_vector.hxx>
 #include <ldb/index/tree/index_query.hxx>
+#include <ldb/index/tree/key_search.hxx>
 #include <ldb/index/tree/payload.hxx>
 
 namespace ldb::index::tree::payloads {
+    /**
+     * The number of values stored inline for a key in a chime_payload. Most keys
+     * of our indices are unique, so a key only needs its own allocation once it
+     * gets duplicated more than this many times.
+     */
+    template<class V>
+    constexpr const static std::size_t chime_inline_values = std::clamp<std::size_t>(16 / sizeof(V), 1, 4);
+
+    template<class V>
+    using chime_value_storage = data::small_vector<V, chime_inline_values<V>>;
+
+    /**
+     * The number of values a key needs to have in a chime_payload before its
+     * values are considered a pool. Pools are unordered, and remember the
+     * position of each value, so a specific value can be removed in constant
+     * time, which matters for keys like "task" shared by huge tuple-bags.
+     */
+    constexpr const static std::size_t chime_pool_threshold = 32;
+
+    template<class V>
+    concept chime_handle_hashable = requires(const V& val) {
+        { val.hash() } -> std::convertible_to<std::size_t>;
+    } || requires(const V& val) {
+        { std::hash<V>{}(val) } -> std::convertible_to<std::size_t>;
+    };
+
+    template<class V>
+    struct chime_handle_hash {
+        [[nodiscard]] std::size_t
+        operator()(const V& val) const noexcept {
+            if constexpr (requires { { val.hash() } -> std::convertible_to<std::size_t>; }) {
+                return val.hash();
+            }
+            else {
+                return std::hash<V>{}(val);
+            }
+        }
+    };
+
     template<std::movable K, std::movable V, std::size_t Clustering>
     struct chime_payload final {
         using key_type = K;
@@ -63,7 +108,7 @@ namespace ldb::index::tree::payloads {
 
         struct bundle_type {
             key_type key;
-            std::vector<value_type> data;
+            chime_value_storage<value_type> data;
         };
 
         constexpr chime_payload() = default;
@@ -72,17 +117,17 @@ namespace ldb::index::tree::payloads {
         constexpr chime_payload(K2&& key, V2&& value)
              : _data_sz(1),
                _keys{std::forward<K2>(key)},
-               _sets{chime_value_set(std::forward<V2>(value))} { }
+               _sets{chime_value_set(std::forward<V2>(value))} { repack(); }
 
         constexpr explicit chime_payload(bundle_type&& bundle)
              : _data_sz(1),
                _keys{std::move(bundle.key)},
-               _sets{chime_value_set(std::move(bundle))} { }
+               _sets{chime_value_set(std::move(bundle))} { repack(); }
 
         constexpr explicit chime_payload(const bundle_type& bundle)
              : _data_sz(1),
                _keys{bundle.key},
-               _sets{chime_value_set(bundle)} { }
+               _sets{chime_value_set(bundle)} { repack(); }
 
         constexpr chime_payload(const chime_payload& cp)
             requires(std::copyable<key_type> && std::copyable<value_type>)
@@ -128,35 +173,26 @@ namespace ldb::index::tree::payloads {
         bool
         try_merge(chime_payload& other) {
             if (capacity() - size() < other.size()) return false;
-            // todo: proper merge algorithm
-            for (std::size_t i = 0; i < other.size(); ++i) {
-                auto succ = try_set(bundle_type{
-                       .key = other._keys[i],
-                       .data = other._sets[i].flush()});
-                assert_that(succ);
-                std::ignore = succ;
-            }
-            other._data_sz = 0;
+            merge_tail_of(other, 0);
             return true;
         }
 
         void
         merge_until_full(chime_payload& other) {
             if (size() == capacity()) return;
-            // todo: proper merge algorithm
-            for (std::size_t i = other.size() - 1;
-                 i < static_cast<std::size_t>(-1);
-                 --i) {
-                auto data = other._sets[i].flush();
-                auto succ = try_set(bundle_type{
-                       .key = other._keys[i],
-                       .data = data});
-                if (!succ) {
-                    other._sets[i].reset(data);
-                    break;
-                }
-                --other._data_sz;
+            // walk both key sets from the top: keys already present in this node
+            // are free to merge, every other key takes up one of our free slots
+            auto free_slots = capacity() - size();
+            auto mine = _data_sz;
+            auto from = other._data_sz;
+            for (; from > 0; --from) {
+                const auto& key = other._keys[from - 1];
+                while (mine > 0 && key < _keys[mine - 1]) --mine;
+                if (mine > 0 && _keys[mine - 1] == key) continue;
+                if (free_slots == 0) break;
+                --free_slots;
             }
+            merge_tail_of(other, from);
         }
 
         [[nodiscard]] bool
@@ -182,6 +218,7 @@ namespace ldb::index::tree::payloads {
                           std::next(std::begin(_sets), static_cast<std::ptrdiff_t>(_data_sz)),
                           std::begin(_sets));
                 --_data_sz;
+                repack();
                 res = upsert_kv(key, {&value, 1});
                 return {squished};
             }
@@ -194,6 +231,7 @@ namespace ldb::index::tree::payloads {
                 res == FULL) {
                 auto squished = bundle_type{.key = _keys.back(), .data = _sets.back().flush()};
                 --_data_sz;
+                repack();
                 res = upsert_kv(key, {&value, 1});
                 return {squished};
             }
@@ -205,7 +243,7 @@ namespace ldb::index::tree::payloads {
             auto [key, data] = std::move(bundle);
             if (auto res = upsert_kv(key, data);
                 res == FULL) {
-                auto squished = bundle_type{.key = _keys[0], .data = _sets[0]};
+                auto squished = bundle_type{.key = _keys[0], .data = _sets[0].flush()};
                 std::move(std::next(std::begin(_keys)),
                           std::next(std::begin(_keys), static_cast<std::ptrdiff_t>(_data_sz)),
                           std::begin(_keys));
@@ -213,6 +251,7 @@ namespace ldb::index::tree::payloads {
                           std::next(std::begin(_sets), static_cast<std::ptrdiff_t>(_data_sz)),
                           std::begin(_sets));
                 --_data_sz;
+                repack();
                 res = upsert_kv(std::move(key), std::move(data));
                 return {squished};
             }
@@ -226,6 +265,7 @@ namespace ldb::index::tree::payloads {
                 res == FULL) {
                 auto squished = bundle_type{.key = _keys.back(), .data = _sets.back().flush()};
                 --_data_sz;
+                repack();
                 res = upsert_kv(std::move(key), std::move(data));
                 return {squished};
             }
@@ -236,12 +276,8 @@ namespace ldb::index::tree::payloads {
         [[nodiscard]] constexpr std::optional<value_type>
         try_get(const Q& query) const noexcept(std::is_nothrow_constructible_v<std::optional<value_type>, value_type>) {
             if (empty()) return std::nullopt;
-            auto data_end = std::next(begin(_keys), static_cast<std::ptrdiff_t>(_data_sz));
-            if (auto it = std::lower_bound(begin(_keys),
-                                           data_end,
-                                           query.key());
-                it != data_end) {
-                const auto col_idx = static_cast<std::size_t>(std::distance(begin(_keys), it));
+            if (const auto col_idx = find_slot(query.key());
+                col_idx != _data_sz) {
                 return _sets[col_idx].get(query);
             }
             return std::nullopt;
@@ -251,11 +287,11 @@ namespace ldb::index::tree::payloads {
         constexpr std::optional<value_type>
         remove(const Q& query) {
             if (empty()) return std::nullopt;
-            auto key_end = std::next(begin(_keys), static_cast<std::ptrdiff_t>(_data_sz));
-            auto it = std::lower_bound(begin(_keys), key_end, query.key());
-            if (it == key_end) return std::nullopt;
+            const auto col_idx = find_slot(query.key());
+            if (col_idx == _data_sz) return std::nullopt;
 
-            const auto col_idx = static_cast<size_type>(std::distance(begin(_keys), it));
+            auto key_end = std::next(begin(_keys), static_cast<std::ptrdiff_t>(_data_sz));
+            auto it = std::next(begin(_keys), static_cast<std::ptrdiff_t>(col_idx));
             auto res = _sets[col_idx].pop(query);
 
             if (_sets[col_idx].empty()) {
@@ -264,6 +300,7 @@ namespace ldb::index::tree::payloads {
                 std::ranges::rotate(it, it + 1, key_end);
                 std::ranges::rotate(data_it, data_it + 1, data_end);
                 --_data_sz;
+                repack();
             }
             return res;
         }
@@ -278,43 +315,79 @@ namespace ldb::index::tree::payloads {
 
 
     private:
+        using position_map = std::conditional_t<chime_handle_hashable<value_type>,
+                                                std::unordered_map<value_type, std::size_t, chime_handle_hash<value_type>>,
+                                                std::monostate>;
+
         struct chime_value_set {
             constexpr chime_value_set() = default;
 
             constexpr explicit chime_value_set(bundle_type&& bundle)
                  : _values(std::move(bundle).data) {
-                //                assert_that(std::ranges::is_sorted(_values) && "chime_value_set must be sorted when constructed from bundle");
+                track_from(0);
             }
 
             constexpr explicit chime_value_set(const bundle_type& bundle)
                  : _values(bundle.data) {
-                //                assert_that(std::ranges::is_sorted(_values) && "chime_value_set must be sorted when constructed from bundle");
+                track_from(0);
             }
 
             template<class SetV>
             constexpr explicit chime_value_set(SetV&& value) // NOLINT(*-forwarding-reference-overload)
-                requires(!std::same_as<SetV, chime_value_set>)
-                 : _values{std::forward<SetV>(value)} { }
+                requires(!std::same_as<std::remove_cvref_t<SetV>, chime_value_set>)
+            {
+                _values.push_back(std::forward<SetV>(value));
+            }
+
+            chime_value_set(const chime_value_set& cp)
+                 : _values(cp._values) {
+                if (cp.pooled()) index_all();
+            }
+
+            chime_value_set(chime_value_set&& mv) noexcept = default;
+
+            chime_value_set&
+            operator=(const chime_value_set& cp) {
+                if (this == &cp) return *this;
+                _values = cp._values;
+                _positions.reset();
+                if (cp.pooled()) index_all();
+                return *this;
+            }
+
+            chime_value_set&
+            operator=(chime_value_set&& mv) noexcept = default;
+
+            ~chime_value_set() noexcept = default;
 
             constexpr void
             push(std::span<const value_type> val) {
-                _values.reserve(_values.size() + val.size());
-                _values.insert(_values.end(), val.begin(), val.end());
+                const auto old_size = _values.size();
+                _values.append(val.begin(), val.end());
+                track_from(old_size);
+            }
+
+            constexpr void
+            append(chime_value_set&& other) {
+                const auto old_size = _values.size();
+                if (_values.empty()) {
+                    _values = std::move(other._values);
+                }
+                else {
+                    _values.append(std::make_move_iterator(other._values.begin()),
+                                   std::make_move_iterator(other._values.end()));
+                }
+                other._values.clear();
+                other._positions.reset();
+                track_from(old_size);
             }
 
             template<index_lookup<value_type> Q>
             [[nodiscard]] constexpr std::optional<value_type>
             pop(Q query) {
                 assert_that(!empty());
-                if (auto it = std::ranges::find_if(_values, [&query](const auto& val) {
-                        return val == query;
-                    });
-                    it != _values.end()) {
-
-                    auto cp = *it;
-                    _values.erase(it);
-                    return cp;
-                }
+                if (const auto idx = find_index(query);
+                    idx != _values.size()) return take(idx);
                 return std::nullopt;
             }
 
@@ -322,16 +395,14 @@ namespace ldb::index::tree::payloads {
             [[nodiscard]] constexpr std::optional<value_type>
             get(const Q& query) const {
                 assert_that(!empty());
-                if (auto it = std::ranges::find_if(_values, [&query](const auto& val) {
-                        return val == query;
-                    });
-                    it != _values.end()) return *it;
+                if (const auto idx = find_index(query);
+                    idx != _values.size()) return _values[idx];
                 return std::nullopt;
             }
 
             [[nodiscard]] constexpr bool
             check(const value_type& val) const {
-                return std::ranges::binary_search(_values, val);
+                return std::ranges::find(_values, val) != _values.end();
             }
 
             [[nodiscard]] constexpr bool
@@ -339,16 +410,15 @@ namespace ldb::index::tree::payloads {
                 return _values.empty();
             }
 
-            constexpr std::vector<value_type>
-            flush() {
-                auto res = std::move(_values);
-                _values = std::vector<value_type>();
-                return res;
+            [[nodiscard]] constexpr bool
+            pooled() const noexcept {
+                return static_cast<bool>(_positions);
             }
 
-            constexpr void
-            reset(std::span<value_type> values) {
-                _values.assign(values.begin(), values.end());
+            constexpr chime_value_storage<value_type>
+            flush() {
+                _positions.reset();
+                return std::exchange(_values, chime_value_storage<value_type>());
             }
 
             template<class Fn>
@@ -368,7 +438,74 @@ namespace ldb::index::tree::payloads {
                 return os << ")";
             }
 
-            std::vector<value_type> _values{};
+            template<index_lookup<value_type> Q>
+            [[nodiscard]] std::size_t
+            find_index(const Q& query) const {
+                if constexpr (handle_lookup<Q, value_type> && chime_handle_hashable<value_type>) {
+                    if (pooled()) {
+                        // the map is only a hint: duplicate values share an entry
+                        if (const auto it = _positions->find(query.value());
+                            it != _positions->end()
+                            && _values[it->second] == query) return it->second;
+                    }
+                }
+                const auto it = std::ranges::find_if(_values, [&query](const auto& val) {
+                    return val == query;
+                });
+                return static_cast<std::size_t>(std::distance(_values.begin(), it));
+            }
+
+            value_type
+            take(std::size_t idx) {
+                auto cp = _values[idx];
+                if constexpr (chime_handle_hashable<value_type>) {
+                    if (pooled()) {
+                        // pools are unordered: fill the hole with the last value
+                        if (const auto it = _positions->find(cp);
+                            it != _positions->end() && it->second == idx) _positions->erase(it);
+                        if (const auto last = _values.size() - 1;
+                            idx != last) {
+                            _values[idx] = std::move(_values[last]);
+                            (*_positions)[_values[idx]] = idx;
+                        }
+                        _values.pop_back();
+                        if (_values.size() < chime_pool_threshold / 2) _positions.reset();
+                        return cp;
+                    }
+                }
+                _values.erase(std::next(_values.begin(), static_cast<std::ptrdiff_t>(idx)));
+                return cp;
+            }
+
+            void
+            track_from(std::size_t first) {
+                if constexpr (chime_handle_hashable<value_type>) {
+                    if (!pooled()) {
+                        if (_values.size() > chime_pool_threshold) index_all();
+                        return;
+                    }
+                    for (auto i = first; i < _values.size(); ++i) {
+                        (*_positions)[_values[i]] = i;
+                    }
+                }
+                else {
+                    std::ignore = first;
+                }
+            }
+
+            void
+            index_all() {
+                if constexpr (chime_handle_hashable<value_type>) {
+                    _positions = std::make_unique<position_map>();
+                    _positions->reserve(_values.size());
+                    for (std::size_t i = 0; i < _values.size(); ++i) {
+                        (*_positions)[_values[i]] = i;
+                    }
+                }
+            }
+
+            chime_value_storage<value_type> _values{};
+            std::unique_ptr<position_map> _positions{};
         };
 
         friend constexpr std::ostream&
@@ -421,11 +558,9 @@ namespace ldb::index::tree::payloads {
         constexpr std::optional<value_type>
         drop(const key_type& key) {
             const auto data_end = next(begin(_keys), _data_sz);
-            const auto it = std::ranges::lower_bound(begin(_keys),
-                                                     data_end,
-                                                     key);
-            if (it == data_end) return std::nullopt;
-            const auto col_idx = distance(begin(_keys), it);
+            const auto col_idx = find_slot(key);
+            if (col_idx == _data_sz) return std::nullopt;
+            const auto it = next(begin(_keys), col_idx);
             const auto res = _sets[col_idx].pop();
             if (_sets[col_idx].empty()) {
                 // remove key-set
@@ -434,6 +569,7 @@ namespace ldb::index::tree::payloads {
                 std::ranges::rotate(sets_it, sets_it + 1, sets_end);
                 std::ranges::rotate(it, it + 1, data_end);
                 std::ignore = _sets[--_data_sz].flush();
+                repack();
             }
             return res;
         }
@@ -452,17 +588,15 @@ namespace ldb::index::tree::payloads {
                     swap(_keys[0], _keys[1]);
                     swap(_sets[0], _sets[1]);
                 }
-
+                repack();
                 return INSERTED;
             }
 
             auto data_end_offset = static_cast<std::ptrdiff_t>(_data_sz);
-            auto it = std::ranges::lower_bound(begin(_keys),
-                                               std::next(begin(_keys), data_end_offset),
-                                               key);
-            if (it == end(_keys)) return FULL;
+            const auto col_idx = find_slot(key);
+            if (col_idx == Clustering) return FULL;
 
-            auto col_idx = static_cast<std::size_t>(std::distance(begin(_keys), it));
+            auto it = std::next(begin(_keys), static_cast<std::ptrdiff_t>(col_idx));
             if (col_idx < _data_sz && *it == key) {
                 _sets[col_idx].push(value);
                 return UPDATED;
@@ -478,12 +612,99 @@ namespace ldb::index::tree::payloads {
             *it = key;
             _sets[col_idx].push(value);
             ++_data_sz;
+            repack();
             return INSERTED;
         }
 
+        template<class Key>
+        [[nodiscard]] constexpr size_type
+        find_slot(const Key& key) const {
+            if (!std::is_constant_evaluated()) {
+                if (const auto slot = _packed.lower_bound(key, _data_sz)) return *slot;
+            }
+            return key_lower_bound(std::span<const key_type>(_keys.data(), _data_sz), key);
+        }
+
+        // keeps the packed copy of the keys in step: call after every change of them
+        constexpr void
+        repack() noexcept {
+            _packed.repack(std::span<const key_type>(_keys.data(), _data_sz));
+        }
+
+        /**
+         * Merges the key-sets of other, starting at index from, into this payload in
+         * a single pass over both sorted key arrays.
+         * The merge is performed backwards in place, so it requires this payload to
+         * have room for every key of other that is not already present.
+         * Value sets are moved, or appended to the set of the equal key in this node.
+         * The merged key-sets are removed from the end of other.
+         */
+        void
+        merge_tail_of(chime_payload& other, const size_type from) {
+            assert_that(from <= other._data_sz);
+
+            size_type duplicates = 0;
+            for (size_type i = 0, j = from; i < _data_sz && j < other._data_sz;) {
+                if (_keys[i] < other._keys[j]) {
+                    ++i;
+                }
+                else if (other._keys[j] < _keys[i]) {
+                    ++j;
+                }
+                else {
+                    ++duplicates;
+                    ++i;
+                    ++j;
+                }
+            }
+            const auto merged_sz = _data_sz + (other._data_sz - from) - duplicates;
+            assert_that(merged_sz <= Clustering);
+
+            auto mine = _data_sz;
+            auto theirs = other._data_sz;
+            auto out = merged_sz;
+            while (theirs > from) {
+                auto& their_key = other._keys[theirs - 1];
+                if (mine > 0 && their_key < _keys[mine - 1]) {
+                    --mine;
+                    --out;
+                    // in place once the rest of theirs only duplicates our keys
+                    if (out != mine) {
+                        _keys[out] = std::move(_keys[mine]);
+                        _sets[out] = std::move(_sets[mine]);
+                    }
+                    continue;
+                }
+
+                --theirs;
+                --out;
+                if (mine > 0 && _keys[mine - 1] == their_key) {
+                    --mine;
+                    _sets[mine].append(std::move(other._sets[theirs]));
+                    if (out != mine) {
+                        _keys[out] = std::move(_keys[mine]);
+                        _sets[out] = std::move(_sets[mine]);
+                    }
+                    continue;
+                }
+                _keys[out] = std::move(their_key);
+                _sets[out] = std::move(other._sets[theirs]);
+            }
+            assert_that(out == mine);
+
+            for (auto i = from; i < other._data_sz; ++i) {
+                std::ignore = other._sets[i].flush();
+            }
+            other._data_sz = from;
+            _data_sz = merged_sz;
+            other.repack();
+            repack();
+        }
+
         std::size_t _data_sz{0};
         std::array<key_type, Clustering> _keys{};
         std::array<chime_value_set, Clustering> _sets{};
+        [[no_unique_address]] packed_keys<key_type, Clustering> _packed{};
     };
     static_assert(payload<chime_payload<int, int, 0>>);
 }
@@ -39,6 +39,7 @@
 
 #include <cstdlib>
 #include <memory>
+#include <type_traits>
 
 #include <ldb/index/tree/payload/chime_payload.hxx>
 #include <ldb/index/tree/payload/scalar_payload.hxx>
@@ -66,6 +67,26 @@ namespace ldb::index::tree {
         return factor;
     }
 
+    /**
+     * The clustering factor measured to be the fastest for a given key-value
+     * pair on the build machine. A value of 0 means no measurement exists, and
+     * the payload_dispatcher falls back to cluster_for_minimized_overhead_effect.
+     *
+     * Specializations are generated by the LindaDB-clustering-tuner program
+     * if the LINDA_DB_TUNE_CLUSTERING CMake option is set.
+     */
+    template<class K, class V>
+    struct tuned_clustering : std::integral_constant<std::size_t, 0> { };
+
+    template<class K, class V>
+    constexpr const static auto tuned_clustering_v = tuned_clustering<K, V>::value;
+}
+
+#ifdef LINDA_DB_TUNED_CLUSTERING
+#  include <ldb/index/tree/tuned_clustering.hxx>
+#endif
+
+namespace ldb::index::tree {
     template<class K, class V, std::size_t Clustering = 0>
     struct payload_dispatcher {
         constexpr const static std::size_t overhead_size = sizeof(std::unique_ptr<int>) * 2
@@ -73,7 +94,9 @@ namespace ldb::index::tree {
         using type = payloads::chime_payload<
                K,
                V,
-               cluster_for_minimized_overhead_effect(sizeof(K) + sizeof(std::vector<V>), overhead_size, Clustering)>;
+               cluster_for_minimized_overhead_effect(sizeof(K) + sizeof(payloads::chime_value_storage<V>),
+                                                     overhead_size,
+                                                     Clustering != 0 ? Clustering : tuned_clustering_v<K, V>)>;
     };
 
     template<class K, class V>
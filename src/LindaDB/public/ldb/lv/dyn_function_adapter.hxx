@@ -66,11 +66,27 @@ namespace ldb::lv {
         }
     };
 
+    template<>
+    struct expecting_visitor<std::string> {
+        std::string
+        operator()(const linda_string& str) {
+            return str.str();
+        }
+
+        template<class T>
+        [[noreturn]] std::string
+        operator()(T&& bad_value) {
+            std::ignore = std::forward<T>(bad_value);
+            assert_that(false, "bad type received at runtime for dynamic call");
+            std::abort();
+        }
+    };
+
     template<>
     struct expecting_visitor<const char*> {
         const char*
-        operator()(const std::string& str) {
-            return str.data();
+        operator()(const linda_string& str) {
+            return str.c_str();
         }
 
         template<class T>
@@ -31,7 +31,7 @@
  * Originally created: 2024-02-22.
  *
  * src/LindaDB/public/ldb/lv/fn_call_holder --
- *   
+ *   A function call stored in a linda_value, to be executed by eval.
  */
 #ifndef LINDADB_FN_CALL_HOLDER_HXX
 #define LINDADB_FN_CALL_HOLDER_HXX
@@ -62,10 +62,10 @@ namespace ldb::lv {
         ~fn_call_holder();
 
         [[nodiscard]] const std::string&
-        fn_name() const { return _fn_name; }
+        fn_name() const noexcept;
 
         [[nodiscard]] const linda_tuple&
-        args() const { return *_args; }
+        args() const noexcept;
 
         /**
          * \brief Executes the stored function call and injects its result into a tuple.
@@ -80,22 +80,24 @@ namespace ldb::lv {
         execute(int after_prefix, const linda_tuple& elements);
 
     private:
-        friend struct ::std::hash<ldb::lv::fn_call_holder>;
+        /// The call is stored out-of-line and shared between copies: it is
+        /// never modified after construction, and this keeps the
+        /// fn_call_holder alternative of linda_value a single pointer.
+        struct call_data;
 
-        std::string _fn_name;
-        std::unique_ptr<linda_tuple> _args;
+        call_data* _call;
 
         friend std::ostream&
         operator<<(std::ostream& os, const fn_call_holder& holder) {
-            return os << "[fn call object: " << holder._fn_name << "]";
+            return os << "[fn call object: " << holder.fn_name() << "]";
         }
 
         friend auto
         operator<=>(const fn_call_holder& rhs,
-                    const fn_call_holder& lhs) { return rhs._fn_name <=> lhs._fn_name; }
+                    const fn_call_holder& lhs) { return rhs.fn_name() <=> lhs.fn_name(); }
         friend auto
         operator==(const fn_call_holder& rhs,
-                   const fn_call_holder& lhs) { return rhs._fn_name == lhs._fn_name; }
+                   const fn_call_holder& lhs) { return rhs.fn_name() == lhs.fn_name(); }
     };
 }
 
@@ -104,7 +106,7 @@ namespace std {
     struct hash<ldb::lv::fn_call_holder> {
         std::size_t
         operator()(const ldb::lv::fn_call_holder& holder) const noexcept {
-            return hash<std::string_view>{}(holder._fn_name);
+            return hash<std::string_view>{}(holder.fn_name());
         }
     };
 }
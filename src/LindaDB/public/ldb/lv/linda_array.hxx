@@ -0,0 +1,266 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/public/ldb/lv/linda_array --
+ *   Binary blob and numeric array values. The elements live in an immutable,
+ *   reference counted, cache-line aligned buffer, shared by copies and by
+ *   slices of the array, so neither copying nor slicing touches the elements.
+ *
+ *  [*]                      [*]  <- linda_arrays: one pointer each
+ *    \                        \
+ *     [refs, -, data, n] <---- [refs, parent, data + k, m]   <- root & slice
+ *                  \
+ *                   [e, e, e, e, ..., e]                     <- aligned elements
+ *
+ *   Arrays compare equal when their elements are bitwise identical, and are
+ *   ordered lexicographically by std::strong_order of the elements, which is
+ *   consistent with that even for floating point elements.
+ */
+#ifndef LINDADB_LINDA_ARRAY_HXX
+#define LINDADB_LINDA_ARRAY_HXX
+
+#include <algorithm>
+#include <atomic>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <ldb/common.hxx>
+
+namespace ldb::lv {
+    namespace helper {
+        /// Alignment of the elements of every linda_array buffer.
+        constexpr const static std::size_t array_alignment = 64;
+
+        /**
+         * The shared representation of a linda_array. Roots own their element
+         * buffer, which directly follows them in the same allocation; slices
+         * point into the buffer of their root, and keep it alive.
+         */
+        struct array_rep {
+            std::atomic<std::size_t> refs;
+            array_rep* root;
+            std::byte* data;
+            std::size_t bytes;
+        };
+
+        /// Allocates a root with an uninitialized buffer of the given size.
+        [[nodiscard]] array_rep*
+        allocate_array(std::size_t bytes);
+
+        /// Creates a slice of the given part of the buffer of rep.
+        [[nodiscard]] array_rep*
+        slice_array(array_rep* rep, std::size_t offset, std::size_t bytes);
+
+        void
+        release_array(array_rep* rep) noexcept;
+
+        inline void
+        retain_array(array_rep* rep) noexcept {
+            if (rep) rep->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    template<class T>
+    concept linda_array_element = std::same_as<T, std::byte>
+                                  || std::same_as<T, std::int32_t>
+                                  || std::same_as<T, std::int64_t>
+                                  || std::same_as<T, float>
+                                  || std::same_as<T, double>;
+
+    template<linda_array_element T>
+    class linda_array final {
+    public:
+        using value_type = T;
+        using const_iterator = const T*;
+
+        linda_array() noexcept = default;
+
+        explicit linda_array(std::span<const T> values)
+             : _rep(allocate(values.size())) {
+            if (_rep) std::memcpy(_rep->data, values.data(), values.size_bytes());
+        }
+
+        linda_array(std::initializer_list<T> values)
+             : linda_array(std::span<const T>(values.begin(), values.size())) { }
+
+        /**
+         * \brief Creates an array of count elements, whose values are written
+         *        by calling fill with a span over the uninitialized elements.
+         *
+         * Lets producers write straight into the shared buffer, without first
+         * building the elements elsewhere and copying them over.
+         */
+        template<std::invocable<std::span<T>> Fill>
+        [[nodiscard]] static linda_array
+        build(std::size_t count, Fill&& fill) {
+            linda_array ret;
+            ret._rep = allocate(count);
+            if (ret._rep) {
+                std::invoke(std::forward<Fill>(fill),
+                            std::span<T>(reinterpret_cast<T*>(ret._rep->data), count));
+            }
+            return ret;
+        }
+
+        linda_array(const linda_array& cp) noexcept
+             : _rep(cp._rep) { helper::retain_array(_rep); }
+
+        linda_array(linda_array&& mv) noexcept
+             : _rep(std::exchange(mv._rep, nullptr)) { }
+
+        linda_array&
+        operator=(const linda_array& cp) noexcept {
+            helper::retain_array(cp._rep);
+            reset(cp._rep);
+            return *this;
+        }
+
+        linda_array&
+        operator=(linda_array&& mv) noexcept {
+            if (this != &mv) reset(std::exchange(mv._rep, nullptr));
+            return *this;
+        }
+
+        ~linda_array() noexcept { reset(nullptr); }
+
+        [[nodiscard]] std::size_t
+        size() const noexcept { return _rep ? _rep->bytes / sizeof(T) : 0; }
+
+        [[nodiscard]] bool
+        empty() const noexcept { return size() == 0; }
+
+        [[nodiscard]] const T*
+        data() const noexcept { return _rep ? reinterpret_cast<const T*>(_rep->data) : nullptr; }
+
+        [[nodiscard]] std::span<const T>
+        span() const noexcept { return {data(), size()}; }
+
+        [[nodiscard]] const_iterator
+        begin() const noexcept { return data(); }
+
+        [[nodiscard]] const_iterator
+        end() const noexcept { return data() + size(); }
+
+        [[nodiscard]] const T&
+        operator[](std::size_t idx) const noexcept {
+            assert_that(idx < size());
+            return data()[idx];
+        }
+
+        /// An array of count elements from offset, sharing this array's buffer.
+        [[nodiscard]] linda_array
+        slice(std::size_t offset, std::size_t count) const {
+            assert_that(offset <= size() && count <= size() - offset);
+            linda_array ret;
+            if (count != 0) ret._rep = helper::slice_array(_rep, offset * sizeof(T), count * sizeof(T));
+            return ret;
+        }
+
+        explicit
+        operator std::vector<T>() const { return std::vector<T>(begin(), end()); }
+
+        [[nodiscard]] std::string_view
+        raw_bytes() const noexcept {
+            return {reinterpret_cast<const char*>(data()), size() * sizeof(T)};
+        }
+
+    private:
+        [[nodiscard]] static helper::array_rep*
+        allocate(std::size_t count) {
+            if (count == 0) return nullptr;
+            return helper::allocate_array(count * sizeof(T));
+        }
+
+        void
+        reset(helper::array_rep* rep) noexcept {
+            if (_rep) helper::release_array(_rep);
+            _rep = rep;
+        }
+
+        friend bool
+        operator==(const linda_array& lhs, const linda_array& rhs) noexcept {
+            if (lhs.size() != rhs.size()) return false;
+            if (lhs.data() == rhs.data()) return true;
+            return std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(T)) == 0;
+        }
+
+        friend std::strong_ordering
+        operator<=>(const linda_array& lhs, const linda_array& rhs) noexcept {
+            return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(),
+                                                          rhs.begin(), rhs.end(),
+                                                          std::strong_order);
+        }
+
+        friend std::ostream&
+        operator<<(std::ostream& os, const linda_array& arr) {
+            constexpr const auto max_printed = 8;
+            os << "[";
+            for (std::size_t i = 0; i < arr.size() && i < max_printed; ++i) {
+                if (i != 0) os << ", ";
+                if constexpr (std::same_as<T, std::byte>) {
+                    os << std::to_integer<int>(arr[i]);
+                }
+                else {
+                    os << arr[i];
+                }
+            }
+            if (arr.size() > max_printed) os << ", ... (" << arr.size() << " elements)";
+            return os << "]";
+        }
+
+        helper::array_rep* _rep = nullptr;
+    };
+
+    /// An opaque binary blob.
+    using linda_bytes = linda_array<std::byte>;
+}
+
+template<ldb::lv::linda_array_element T>
+struct std::hash<ldb::lv::linda_array<T>> {
+    std::size_t
+    operator()(const ldb::lv::linda_array<T>& arr) const noexcept {
+        return std::hash<std::string_view>{}(arr.raw_bytes());
+    }
+};
+
+#endif
@@ -0,0 +1,250 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/public/ldb/lv/linda_string --
+ *   The string type stored in linda_values. It is a single pointer wide, so the
+ *   string alternative does not make every linda_value pay for a std::string.
+ *   Short strings are stored inline, longer ones in an immutable, reference
+ *   counted heap block shared between copies.
+ *
+ *   The low bit of the byte holding the pointer's least significant bits
+ *   distinguishes the two, as heap blocks are always at least 2-aligned.
+ *
+ *  [(len << 1) | 1, c, c, c, \0, _, _, _]    <- inline (little-endian)
+ *  [*                                   ]    <- heap
+ *    \
+ *     [refs, size, c, c, c, ..., \0]
+ */
+#ifndef LINDADB_LINDA_STRING_HXX
+#define LINDADB_LINDA_STRING_HXX
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace ldb::lv {
+    struct linda_string final {
+        using size_type = std::size_t;
+
+        /// The longest string stored without allocation: the tag byte and the
+        /// terminating null take up the rest.
+        constexpr const static size_type inline_capacity = sizeof(void*) - 2;
+
+        linda_string() noexcept { reset(); }
+
+        linda_string(std::string_view str) { // NOLINT(*-explicit-constructor)
+            if (str.size() <= inline_capacity) {
+                std::memcpy(inline_chars(), str.data(), str.size());
+                inline_chars()[str.size()] = '\0';
+                set_inline_size(str.size());
+            }
+            else {
+                set_block(allocate_block(str));
+            }
+        }
+
+        linda_string(const std::string& str) // NOLINT(*-explicit-constructor)
+             : linda_string(std::string_view(str)) { }
+
+        linda_string(const char* str) // NOLINT(*-explicit-constructor)
+             : linda_string(std::string_view(str)) { }
+
+        linda_string(const linda_string& cp) noexcept
+             : _repr(cp._repr) {
+            if (!is_inline()) block()->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        linda_string(linda_string&& mv) noexcept
+             : _repr(mv._repr) {
+            mv.reset();
+        }
+
+        linda_string&
+        operator=(const linda_string& cp) noexcept {
+            linda_string(cp).swap(*this);
+            return *this;
+        }
+
+        linda_string&
+        operator=(linda_string&& mv) noexcept {
+            linda_string(std::move(mv)).swap(*this);
+            return *this;
+        }
+
+        ~linda_string() noexcept {
+            if (!is_inline()) release_block(block());
+        }
+
+        void
+        swap(linda_string& other) noexcept {
+            std::swap(_repr, other._repr);
+        }
+
+        [[nodiscard]] bool
+        is_inline() const noexcept {
+            return (_repr[tag_byte] & 1U) != 0;
+        }
+
+        [[nodiscard]] size_type
+        size() const noexcept {
+            if (is_inline()) return _repr[tag_byte] >> 1U;
+            return block()->size;
+        }
+
+        [[nodiscard]] bool
+        empty() const noexcept { return size() == 0; }
+
+        [[nodiscard]] const char*
+        data() const noexcept {
+            if (is_inline()) return inline_chars();
+            return block_chars(block());
+        }
+
+        [[nodiscard]] const char*
+        c_str() const noexcept { return data(); }
+
+        [[nodiscard]] std::string_view
+        view() const noexcept { return {data(), size()}; }
+
+        [[nodiscard]] std::string
+        str() const { return std::string(view()); }
+
+        operator std::string_view() const noexcept { // NOLINT(*-explicit-constructor)
+            return view();
+        }
+
+        explicit operator std::string() const { return str(); }
+
+    private:
+        struct heap_block {
+            std::atomic<size_type> refs;
+            size_type size;
+        };
+
+        constexpr const static std::size_t tag_byte = std::endian::native == std::endian::little
+                                                             ? 0
+                                                             : sizeof(void*) - 1;
+
+        static heap_block*
+        allocate_block(std::string_view str);
+
+        static void
+        release_block(heap_block* block) noexcept;
+
+        static const char*
+        block_chars(const heap_block* block) noexcept {
+            return reinterpret_cast<const char*>(block + 1);
+        }
+
+        char*
+        inline_chars() noexcept {
+            return reinterpret_cast<char*>(_repr.data() + (tag_byte == 0 ? 1 : 0));
+        }
+
+        [[nodiscard]] const char*
+        inline_chars() const noexcept {
+            return reinterpret_cast<const char*>(_repr.data() + (tag_byte == 0 ? 1 : 0));
+        }
+
+        void
+        reset() noexcept {
+            _repr = {};
+            set_inline_size(0);
+        }
+
+        void
+        set_inline_size(size_type size) noexcept {
+            _repr[tag_byte] = static_cast<unsigned char>((size << 1U) | 1U);
+        }
+
+        [[nodiscard]] heap_block*
+        block() const noexcept {
+            heap_block* ptr;
+            std::memcpy(&ptr, _repr.data(), sizeof(ptr));
+            return ptr;
+        }
+
+        void
+        set_block(heap_block* ptr) noexcept {
+            std::memcpy(_repr.data(), &ptr, sizeof(ptr));
+        }
+
+        friend std::strong_ordering
+        operator<=>(const linda_string& lhs, const linda_string& rhs) noexcept {
+            return lhs.view() <=> rhs.view();
+        }
+
+        friend bool
+        operator==(const linda_string& lhs, const linda_string& rhs) noexcept {
+            if (lhs._repr == rhs._repr) return true; // same inline bytes or same shared block
+            return lhs.view() == rhs.view();
+        }
+
+        friend std::strong_ordering
+        operator<=>(const linda_string& lhs, std::string_view rhs) noexcept {
+            return lhs.view() <=> rhs;
+        }
+
+        friend bool
+        operator==(const linda_string& lhs, std::string_view rhs) noexcept {
+            return lhs.view() == rhs;
+        }
+
+        friend std::ostream&
+        operator<<(std::ostream& os, const linda_string& str) {
+            return os << str.view();
+        }
+
+        alignas(void*) std::array<unsigned char, sizeof(void*)> _repr{};
+    };
+    static_assert(sizeof(linda_string) == sizeof(void*));
+}
+
+namespace std {
+    template<>
+    struct hash<ldb::lv::linda_string> {
+        std::size_t
+        operator()(const ldb::lv::linda_string& str) const noexcept {
+            return hash<std::string_view>{}(str.view());
+        }
+    };
+}
+
+#endif
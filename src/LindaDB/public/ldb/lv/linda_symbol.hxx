@@ -0,0 +1,136 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/public/ldb/lv/linda_symbol --
+ *   An interned string value, meant for the tag-like strings most tuples start
+ *   with, like "task" or "result". Each distinct text is stored once in a
+ *   process-wide intern table, and symbols only hold a pointer to their entry,
+ *   so copying, equality and hashing are all constant time.
+ *
+ *   Entries are never freed: symbols are meant for a small set of tags, not
+ *   for arbitrary data.
+ */
+#ifndef LINDADB_LINDA_SYMBOL_HXX
+#define LINDADB_LINDA_SYMBOL_HXX
+
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace ldb::lv {
+    struct linda_symbol final {
+        /// An entry of the intern table.
+        struct entry {
+            std::size_t hash;
+            std::string text;
+        };
+
+        /// The empty symbol, which never touches the intern table.
+        constexpr linda_symbol() noexcept = default;
+
+        explicit linda_symbol(std::string_view text)
+             : _entry(intern(text)) { }
+
+        [[nodiscard]] std::string_view
+        view() const noexcept {
+            if (!_entry) return {};
+            return _entry->text;
+        }
+
+        [[nodiscard]] std::string
+        str() const { return std::string(view()); }
+
+        [[nodiscard]] std::size_t
+        size() const noexcept { return view().size(); }
+
+        [[nodiscard]] bool
+        empty() const noexcept { return _entry == nullptr; }
+
+        [[nodiscard]] std::size_t
+        hash() const noexcept {
+            if (!_entry) return std::hash<std::string_view>{}({});
+            return _entry->hash;
+        }
+
+        /**
+         * \brief Returns the entry of the given text in the intern table, adding
+         *        it if it is not yet present. The empty string is never added.
+         *
+         * \remarks Safe to call concurrently.
+         */
+        static const entry*
+        intern(std::string_view text);
+
+    private:
+        const entry* _entry = nullptr;
+
+        friend bool
+        operator==(linda_symbol lhs, linda_symbol rhs) noexcept {
+            return lhs._entry == rhs._entry;
+        }
+
+        /// Orders by text, so symbols sort the same way their strings would.
+        friend std::strong_ordering
+        operator<=>(linda_symbol lhs, linda_symbol rhs) noexcept {
+            if (lhs._entry == rhs._entry) return std::strong_ordering::equal;
+            return lhs.view() <=> rhs.view();
+        }
+
+        friend std::ostream&
+        operator<<(std::ostream& os, linda_symbol sym) {
+            return os << sym.view();
+        }
+    };
+    static_assert(sizeof(linda_symbol) == sizeof(void*));
+
+    inline namespace literals {
+        inline linda_symbol
+        operator""_sym(const char* str, std::size_t len) {
+            return linda_symbol(std::string_view(str, len));
+        }
+    }
+}
+
+namespace std {
+    template<>
+    struct hash<ldb::lv::linda_symbol> {
+        std::size_t
+        operator()(ldb::lv::linda_symbol sym) const noexcept {
+            return sym.hash();
+        }
+    };
+}
+
+#endif
@@ -40,13 +40,17 @@
 #define LINDADB_LINDA_TUPLE_HXX
 
 #include <algorithm>
-#include <array>
+#include <atomic>
 #include <cassert>
 #include <compare>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <limits>
+#include <new>
+#include <memory>
 #include <ostream>
 #include <span>
 #include <type_traits>
@@ -86,51 +90,100 @@ namespace ldb::lv {
         using match_constness_of = match_constness_of_impl<T, U>::type;
     }
 
+    /**
+     * \brief A packed description of the shape of a tuple: its arity and the
+     *        type of its leading fields.
+     *
+     * The lowest byte holds the arity (saturated), and each following group of
+     * `tag_bits` holds the linda_value alternative index of one field, for the first
+     * `tagged_fields` fields. Tuples with different signatures can never be
+     * equal, or match the same query, so comparing signatures is a cheap
+     * pre-filter. Equal signatures prove nothing.
+     */
+    struct tuple_signature final {
+        constexpr const static std::size_t arity_bits = 8;
+        constexpr const static std::size_t tag_bits = 5;
+        constexpr const static std::size_t tagged_fields = (64 - arity_bits) / tag_bits;
+        static_assert(std::variant_size_v<linda_value> < (1U << tag_bits));
+
+        [[nodiscard]] constexpr static std::uint64_t
+        of_arity(std::size_t arity) noexcept {
+            constexpr const auto max_arity = (std::uint64_t{1} << arity_bits) - 1;
+            return std::min<std::uint64_t>(arity, max_arity);
+        }
+
+        [[nodiscard]] constexpr static std::uint64_t
+        with_field(std::uint64_t signature, std::size_t field, std::size_t type_tag) noexcept {
+            if (field >= tagged_fields) return signature;
+            return signature | (static_cast<std::uint64_t>(type_tag) << (arity_bits + field * tag_bits));
+        }
+    };
+
     struct linda_tuple final {
-        explicit linda_tuple()
-             : _size(0) { }
+        explicit linda_tuple() noexcept = default;
 
-        explicit linda_tuple(linda_value lv1)
-             : _size(1),
-               _data_ref{std::move(lv1)} { }
+        template<class... Args>
+        explicit linda_tuple(Args&&... lvn)
+            requires(sizeof...(Args) > 0
+                     && !(std::same_as<std::remove_cvref_t<Args>, linda_tuple> || ...)
+                     && (std::constructible_from<linda_value, Args &&> && ...))
+             : _size(sizeof...(Args)),
+               _block(allocate(sizeof...(Args))) {
+            std::size_t built = 0;
+            try {
+                ((std::construct_at(_block->values() + built, std::forward<Args>(lvn)), ++built), ...);
+            } catch (...) {
+                destroy(_block, built, _size);
+                throw;
+            }
+        }
 
-        explicit linda_tuple(linda_value lv1, linda_value lv2)
-             : _size(2),
-               _data_ref{std::move(lv1), std::move(lv2)} { }
+        explicit linda_tuple(std::span<linda_value> vals)
+             : _size(vals.size()),
+               _block(copy_values(vals.data(), vals.size())) { }
 
-        explicit linda_tuple(linda_value lv1, linda_value lv2, linda_value lv3)
-             : _size(3),
-               _data_ref{std::move(lv1), std::move(lv2), std::move(lv3)} { }
+        explicit linda_tuple(std::vector<linda_value>&& vals)
+             : _size(vals.size()),
+               _block(allocate(vals.size())) {
+            if (_block) std::uninitialized_move(vals.begin(), vals.end(), _block->values());
+        }
 
-        explicit linda_tuple(linda_value lv1, linda_value lv2, linda_value lv3, linda_value lv4)
-             : _size(4),
-               _data_ref{std::move(lv1), std::move(lv2), std::move(lv3)},
-               _tail(std::move(lv4)) { }
+        linda_tuple(const linda_tuple& cp)
+             : _size(cp._size),
+               _block(cp.share_block()) { }
+
+        linda_tuple(linda_tuple&& mv) noexcept
+             : _size(std::exchange(mv._size, 0)),
+               _block(std::exchange(mv._block, nullptr)) { }
+
+        linda_tuple&
+        operator=(const linda_tuple& cp) {
+            if (this == &cp) return *this;
+            auto* block = cp.share_block();
+            unref(_block, _size);
+            _size = cp._size;
+            _block = block;
+            return *this;
+        }
 
-        template<class... Args>
-        explicit linda_tuple(linda_value lv1, linda_value lv2, linda_value lv3, linda_value lv4, Args&&... lvn)
-            requires(sizeof...(Args) > 0)
-             : _size(4 + sizeof...(Args)),
-               _data_ref{std::move(lv1), std::move(lv2), std::move(lv3)},
-               _tail(std::vector<linda_value>{lv4, linda_value(std::forward<Args>(lvn))...}) { }
+        linda_tuple&
+        operator=(linda_tuple&& mv) noexcept {
+            if (this == &mv) return *this;
+            unref(_block, _size);
+            _size = std::exchange(mv._size, 0);
+            _block = std::exchange(mv._block, nullptr);
+            return *this;
+        }
 
-        explicit linda_tuple(std::span<linda_value> vals)
-             : _size(vals.size()) {
-            if (vals.empty()) return;
-            if (vals.size() <= 3) {
-                std::ranges::copy(vals, _data_ref.begin());
-            }
-            else {
-                using std::begin;
-                using std::end;
-                std::ranges::copy(begin(vals), std::next(begin(vals), 3), _data_ref.begin());
-                if (vals.size() == 4) {
-                    _tail = vals[3];
-                }
-                else {
-                    _tail = std::vector<linda_value>(std::next(begin(vals), 3), end(vals));
-                }
-            }
+        ~linda_tuple() noexcept {
+            unref(_block, _size);
+        }
+
+        void
+        swap(linda_tuple& other) noexcept {
+            using std::swap;
+            swap(_size, other._size);
+            swap(_block, other._block);
         }
 
         [[nodiscard]] std::size_t
@@ -138,6 +191,18 @@ namespace ldb::lv {
             return _size;
         }
 
+        /**
+         * \brief A well-mixed, order-dependent 64-bit hash of the fields.
+         *
+         * Computed on first use and cached with the values; copies inherit it.
+         */
+        [[nodiscard]] std::uint64_t
+        hash() const noexcept;
+
+        /// The tuple_signature of the tuple, computed on first use and cached.
+        [[nodiscard]] std::uint64_t
+        signature() const noexcept;
+
         [[nodiscard]] std::unique_ptr<linda_tuple>
         clone() const { return std::make_unique<linda_tuple>(*this); }
 
@@ -147,10 +212,19 @@ namespace ldb::lv {
         }
 
         [[nodiscard]] bool
-        operator==(const linda_tuple& rhs) const noexcept = default;
+        operator==(const linda_tuple& rhs) const noexcept {
+            if (_size != rhs._size) return false;
+            if (_size == 0 || _block == rhs._block) return true;
+            // only trust what is already known: computing either word costs a full pass
+            if (const auto lhs_hash = _block->cached_hash(),
+                rhs_hash = rhs._block->cached_hash();
+                lhs_hash != 0 && rhs_hash != 0 && lhs_hash != rhs_hash) return false;
+            return std::equal(_block->values(), _block->values() + _size, rhs._block->values());
+        }
 
+        /// Mutable access unshares the values, so it may allocate.
         [[nodiscard]] linda_value&
-        operator[](std::size_t idx) noexcept { return get_at(idx); }
+        operator[](std::size_t idx) { return get_at(idx); }
 
         [[nodiscard]] const linda_value&
         operator[](std::size_t idx) const noexcept { return get_at(idx); }
@@ -363,18 +437,124 @@ namespace ldb::lv {
         friend std::ostream&
         operator<<(std::ostream& os, const linda_tuple& tuple);
 
+        /**
+         * The single allocation of a tuple: a reference count, the words cached
+         * about the values, directly followed by the values themselves. Zero in
+         * a cached word means it is not yet computed.
+         *
+         * Blocks are immutable while shared. Mutable access first makes the
+         * block exclusive to its tuple, then marks it unshareable, as the
+         * returned reference may outlive the access: copies of such a tuple
+         * get their own block.
+         */
+        struct block {
+            std::atomic<std::size_t> refs{1};
+            std::atomic<std::uint64_t> hash{0};
+            std::atomic<std::uint64_t> signature{0};
+            bool shareable{true};
+
+            [[nodiscard]] linda_value*
+            values() noexcept {
+                return reinterpret_cast<linda_value*>(this + 1);
+            }
+
+            [[nodiscard]] const linda_value*
+            values() const noexcept {
+                return reinterpret_cast<const linda_value*>(this + 1);
+            }
+
+            [[nodiscard]] std::uint64_t
+            cached_hash() const noexcept { return hash.load(std::memory_order_relaxed); }
+
+            [[nodiscard]] std::uint64_t
+            cached_signature() const noexcept { return signature.load(std::memory_order_relaxed); }
+
+            void
+            forget() noexcept {
+                if (cached_hash() != 0) hash.store(0, std::memory_order_relaxed);
+                if (cached_signature() != 0) signature.store(0, std::memory_order_relaxed);
+            }
+        };
+        static_assert(sizeof(block) % alignof(linda_value) == 0);
+
         [[nodiscard]] linda_value&
-        get_at(std::size_t idx) noexcept;
+        get_at(std::size_t idx) {
+            assert_that(idx < _size);
+            if (_block->shareable) {
+                if (_block->refs.load(std::memory_order_acquire) != 1) {
+                    auto* own = copy_values(_block->values(), _size);
+                    unref(_block, _size);
+                    _block = own;
+                }
+                _block->shareable = false;
+            }
+            // the caller may write through the reference: the cached words go stale
+            _block->forget();
+            return _block->values()[idx];
+        }
 
         [[nodiscard]] const linda_value&
-        get_at(std::size_t idx) const noexcept;
+        get_at(std::size_t idx) const noexcept {
+            assert_that(idx < _size);
+            return _block->values()[idx];
+        }
 
-        std::size_t _size;
-        std::array<linda_value, 3> _data_ref{};
-        std::variant<std::monostate,
-                     linda_value,
-                     std::vector<linda_value>>
-               _tail{};
+        [[nodiscard]] constexpr static std::size_t
+        block_bytes(std::size_t count) noexcept {
+            return sizeof(block) + count * sizeof(linda_value);
+        }
+
+        [[nodiscard]] static block*
+        allocate(std::size_t count) {
+            if (count == 0) return nullptr;
+            return ::new (::operator new(block_bytes(count))) block{};
+        }
+
+        static void
+        destroy(block* blk, std::size_t built, std::size_t count) noexcept {
+            if (!blk) return;
+            std::destroy_n(blk->values(), built);
+            blk->~block();
+            ::operator delete(blk, block_bytes(count));
+        }
+
+        static void
+        unref(block* blk, std::size_t count) noexcept {
+            if (!blk) return;
+            if (blk->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+            destroy(blk, count, count);
+        }
+
+        [[nodiscard]] static block*
+        copy_values(const linda_value* src, std::size_t count) {
+            auto* blk = allocate(count);
+            if (!blk) return nullptr;
+            try {
+                std::uninitialized_copy_n(src, count, blk->values());
+            } catch (...) {
+                destroy(blk, 0, count);
+                throw;
+            }
+            return blk;
+        }
+
+        [[nodiscard]] block*
+        share_block() const {
+            if (!_block) return nullptr;
+            if (_block->shareable) {
+                _block->refs.fetch_add(1, std::memory_order_relaxed);
+                return _block;
+            }
+            auto* blk = copy_values(_block->values(), _size);
+            blk->hash.store(_block->cached_hash(), std::memory_order_relaxed);
+            blk->signature.store(_block->cached_signature(), std::memory_order_relaxed);
+            return blk;
+        }
+
+        // all values live in a single, right-sized block, which copies share:
+        // neither moving nor copying a tuple touches the values
+        std::size_t _size{0};
+        block* _block{nullptr};
 
     public:
         using iterator = iterator_impl<linda_value>;
@@ -403,13 +583,9 @@ namespace ldb::lv {
 namespace std {
     template<>
     struct hash<ldb::lv::linda_tuple> {
-        constexpr std::size_t
+        std::size_t
         operator()(const ldb::lv::linda_tuple& tuple) const noexcept {
-            std::size_t result = 0;
-            for (const auto& val : tuple) {
-                result ^= std::hash<ldb::lv::linda_value>{}(val);
-            }
-            return result;
+            return static_cast<std::size_t>(tuple.hash());
         }
     };
 }
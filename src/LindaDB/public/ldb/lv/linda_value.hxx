@@ -31,6 +31,9 @@
  * Originally created: 2023-10-18.
  *
  * src/LindaDB/public/ldb/lv/linda_value --
+ *   The type of a single field of a linda_tuple. Every alternative is at most
+ *   pointer sized, so a linda_value is 16 bytes on 64-bit platforms: strings
+ *   and function calls are stored out-of-line if they do not fit.
  */
 
 #ifndef LINDADB_LINDA_VALUE_HXX
@@ -43,9 +46,13 @@
 #include <string_view>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 #include <ldb/lv/fn_call_holder.hxx>
 #include <ldb/lv/fn_call_tag.hxx>
+#include <ldb/lv/linda_array.hxx>
+#include <ldb/lv/linda_string.hxx>
+#include <ldb/lv/linda_symbol.hxx>
 
 namespace ldb::lv {
     using linda_value = std::variant<
@@ -55,21 +62,32 @@ namespace ldb::lv {
            std::uint32_t,
            std::int64_t,
            std::uint64_t,
-           std::string,
+           linda_string,
            float,
            double,
            fn_call_holder,
-           fn_call_tag>;
+           fn_call_tag,
+           linda_symbol,
+           linda_bytes,
+           linda_array<std::int32_t>,
+           linda_array<std::int64_t>,
+           linda_array<float>,
+           linda_array<double>>;
+    static_assert(sizeof(linda_value) <= 2 * sizeof(void*));
 
     template<class T>
     inline linda_value
     make_linda_value(T&& val) { return linda_value(std::forward<T>(val)); }
 
     inline linda_value
-    make_linda_value(std::string_view val) { return linda_value(std::string(val)); }
+    make_linda_value(std::string_view val) { return linda_value(linda_string(val)); }
 
     inline linda_value
-    make_linda_value(const std::string& val) { return linda_value(val); }
+    make_linda_value(const std::string& val) { return linda_value(linda_string(val)); }
+
+    template<linda_array_element T>
+    inline linda_value
+    make_linda_value(const std::vector<T>& val) { return linda_value(linda_array<T>(val)); }
 
     namespace helper {
         struct printer {
@@ -100,6 +118,10 @@ namespace ldb::lv {
     template<class T>
     struct is_linda_value : std::bool_constant<helper::is_member_of<T, linda_value>::value> { };
 
+    template<>
+    struct is_linda_value<std::string> : std::true_type { };
+    template<>
+    struct is_linda_value<std::string_view> : std::true_type { };
     template<std::size_t N>
     struct is_linda_value<const char[N]> : std::true_type { };
     template<std::size_t N>
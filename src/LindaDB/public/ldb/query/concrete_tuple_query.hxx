@@ -39,6 +39,7 @@
 #include <cassert>
 #include <compare>
 #include <cstddef>
+#include <cstdint>
 
 #include <ldb/index/tree/index_query.hxx> // NOLINT(*-include-cleaner) actually used
 #include <ldb/lv/linda_tuple.hxx>
@@ -62,6 +63,10 @@ namespace ldb {
         explicit concrete_tuple_query(const lv::linda_tuple& tuple)
              : _tuple(tuple) { }
 
+        /// The tuple_signature every tuple matching this query has.
+        [[nodiscard]] std::uint64_t
+        signature() const noexcept { return _tuple.signature(); }
+
         [[nodiscard]] field_match_type<value_type>
         search_via_field(std::size_t field_index,
                          const IndexType& db_index) const {
@@ -114,13 +119,13 @@ namespace ldb {
 
         friend constexpr bool
         operator==(const lv::linda_tuple& lt, const concrete_tuple_query& query) {
-            return std::is_eq(lt <=> query);
+            return lt == query._tuple;
         }
 
         template<meta::tuple_wrapper TupleWrapper>
         friend constexpr bool
         operator==(const TupleWrapper& tw, const concrete_tuple_query& query) {
-            return std::is_eq(*tw <=> query);
+            return *tw == query._tuple;
         }
     };
 }
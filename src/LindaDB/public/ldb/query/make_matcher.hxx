@@ -100,6 +100,17 @@ namespace ldb::meta {
         }
     };
 
+    template<class P>
+    struct make_matcher_impl<match_type<P>&> {
+        using type = match_type<P>;
+
+        template<class M = match_type<P>>
+        constexpr auto
+        operator()(const M& matcher) const noexcept {
+            return matcher;
+        }
+    };
+
     template<class P>
     struct make_matcher_impl<match_type<P>> {
         using type = match_type<P>;
@@ -39,8 +39,10 @@
 #include <compare>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <tuple>
 #include <utility>
+#include <variant>
 
 #include <ldb/index/tree/index_query.hxx> // NOLINT(*-include-cleaner) actually used
 #include <ldb/lv/linda_tuple.hxx>
@@ -66,7 +68,38 @@ namespace ldb {
         explicit constexpr manual_fields_query(Args&&... args) noexcept((
                std::is_nothrow_constructible_v<Matchers, Args> && ...))
             requires((!std::same_as<Args, manual_fields_query> && ...))
-             : _payload(meta::make_matcher<Args>(std::forward<Args>(args))...) { }
+             : _payload(meta::make_matcher<Args>(std::forward<Args>(args))...),
+               _signature(compute_signature()) { }
+
+        /// The tuple_signature every tuple matching this query has, or zero if unknown.
+        [[nodiscard]] std::uint64_t
+        signature() const noexcept { return _signature; }
+
+        /**
+         * Matches a tuple with the plan compiled from the matchers: arity and
+         * field types in one word via the signature, then the fields cheap to
+         * check (formals and scalar values), then the rest, like strings.
+         * Formals are only written once the whole tuple matched.
+         */
+        [[nodiscard]] bool
+        matches(const lv::linda_tuple& lt) const {
+            if (!accepts(lt)) return false;
+            [&lt, this]<std::size_t... Is>(std::index_sequence<Is...>) {
+                (bind_field(std::get<Is>(_payload), lt[Is]), ...);
+            }(std::make_index_sequence<sizeof...(Matchers)>());
+            return true;
+        }
+
+        /// Whether lt matches, without writing the formals.
+        [[nodiscard]] bool
+        accepts(const lv::linda_tuple& lt) const {
+            if (lt.size() != sizeof...(Matchers)) return false;
+            if (_signature != 0 && lt.signature() != _signature) return false;
+            return [&lt, this]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return ((!cheap_field<Is> || std::get<Is>(_payload).matches(lt[Is])) && ...)
+                       && ((cheap_field<Is> || std::get<Is>(_payload).matches(lt[Is])) && ...);
+            }(std::make_index_sequence<sizeof...(Matchers)>());
+        }
 
         [[nodiscard]] field_match_type<value_type>
         search_via_field(std::size_t field_index,
@@ -106,6 +139,31 @@ namespace ldb {
         constexpr const static auto CONTINUE_LOOP = true;
         constexpr const static auto TERMINATE_LOOP = false;
 
+        // matchers owning nothing compare without chasing pointers
+        template<std::size_t I>
+        constexpr const static bool cheap_field = std::is_trivially_copyable_v<
+               std::tuple_element_t<I, std::tuple<meta::matcher_type<Matchers>...>>>;
+
+        template<class MatcherImplType>
+        static void
+        bind_field(const MatcherImplType& matcher_impl, const lv::linda_value& value) {
+            if constexpr (requires { matcher_impl.bind(value); }) matcher_impl.bind(value);
+        }
+
+        [[nodiscard]] constexpr std::uint64_t
+        compute_signature() const noexcept {
+            return [this]<std::size_t... Is>(std::index_sequence<Is...>) -> std::uint64_t {
+                auto signature = lv::tuple_signature::of_arity(sizeof...(Matchers));
+                const auto typed = ([this, &signature] {
+                    const auto type_index = std::get<Is>(_payload).template type_index<lv::linda_value>();
+                    if (type_index == std::variant_npos) return false;
+                    signature = lv::tuple_signature::with_field(signature, Is, type_index);
+                    return true;
+                }() && ...);
+                return typed ? signature : 0;
+            }(std::make_index_sequence<sizeof...(Matchers)>());
+        }
+
         template<class Fn>
         [[nodiscard]] field_match_type<value_type>
         iterate_matchers_via(Fn&& fn) const {
@@ -158,7 +216,7 @@ namespace ldb {
             if (lt.size() != sizeof...(Matchers)) return lt.size() <=> sizeof...(Matchers);
             return [&lt, &payload = query._payload]<std::size_t... Is>(std::index_sequence<Is...>) {
                 std::partial_ordering order = std::strong_ordering::equal;
-                std::ignore = (matcher(order)(std::get<Is>(payload) <=> lt[Is]) && ...);
+                std::ignore = (matcher(order)(lt[Is] <=> std::get<Is>(payload)) && ...);
                 return order;
             }(std::make_index_sequence<sizeof...(Matchers)>());
         }
@@ -169,23 +227,24 @@ namespace ldb {
             if (tw->size() != sizeof...(Matchers)) return tw->size() <=> sizeof...(Matchers);
             return [&tw, &payload = query._payload]<std::size_t... Is>(std::index_sequence<Is...>) {
                 std::partial_ordering order = std::strong_ordering::equal;
-                std::ignore = (matcher(order)(std::get<Is>(payload) <=> (*tw)[Is]) && ...);
+                std::ignore = (matcher(order)(std::as_const(*tw)[Is] <=> std::get<Is>(payload)) && ...);
                 return order;
             }(std::make_index_sequence<sizeof...(Matchers)>());
         }
 
         friend constexpr bool
         operator==(const lv::linda_tuple& lt, const manual_fields_query& query) {
-            return (lt <=> query) == 0;
+            return query.matches(lt);
         }
 
         template<meta::tuple_wrapper TupleWrapper>
         friend constexpr bool
         operator==(const TupleWrapper& tw, const manual_fields_query& query) {
-            return (*tw <=> query) == 0;
+            return query.matches(*tw);
         }
 
         std::tuple<meta::matcher_type<Matchers>...> _payload;
+        std::uint64_t _signature;
     };
 
     namespace helper {
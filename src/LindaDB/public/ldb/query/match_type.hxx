@@ -52,13 +52,14 @@ namespace ldb {
         constexpr explicit match_type(T* ref) noexcept : _ref(ref) { }
 
         template<class... Args>
-        [[nodiscard]] constexpr auto
-        operator<=>(const std::variant<Args...>& value) const noexcept
-            requires((std::same_as<T, Args> || ...))
+        [[nodiscard]] friend constexpr auto
+        operator<=>(const std::variant<Args...>& value, const match_type& mt) noexcept
+            requires((std::same_as<meta::stored_alternative_t<T>, Args> || ...))
         {
-            if (auto found = std::get_if<T>(&value);
+            using stored_type = meta::stored_alternative_t<T>;
+            if (auto found = std::get_if<stored_type>(&value);
                 found) {
-                *_ref = *found;
+                *mt._ref = static_cast<T>(*found);
                 return std::strong_ordering::equal;
             }
 
@@ -69,7 +70,7 @@ namespace ldb {
             }(std::make_index_sequence<sizeof...(Args)>());
             auto t_idx = []<std::size_t... Is>(std::index_sequence<Is...>) {
                 std::size_t idx{};
-                (meta::finder(idx)(std::same_as<T, Args>, Is) || ...);
+                (meta::finder(idx)(std::same_as<stored_type, Args>, Is) || ...);
                 return idx;
             }(std::make_index_sequence<sizeof...(Args)>());
 
@@ -79,6 +80,33 @@ namespace ldb {
         constexpr static std::false_type
         indexable() { return {}; }
 
+        /// Whether value can be bound: a type check only, nothing is written.
+        template<class... Args>
+        [[nodiscard]] constexpr bool
+        matches(const std::variant<Args...>& value) const noexcept
+            requires((std::same_as<meta::stored_alternative_t<T>, Args> || ...))
+        {
+            return std::holds_alternative<meta::stored_alternative_t<T>>(value);
+        }
+
+        /// Writes a value that matches() into the bound variable.
+        template<class... Args>
+        constexpr void
+        bind(const std::variant<Args...>& value) const
+            requires((std::same_as<meta::stored_alternative_t<T>, Args> || ...))
+        {
+            *_ref = static_cast<T>(*std::get_if<meta::stored_alternative_t<T>>(&value));
+        }
+
+        /// The variable a match is written into.
+        [[nodiscard]] constexpr T*
+        target() const noexcept { return _ref; }
+
+        /// The index of the alternative of Variant this matcher can match.
+        template<class Variant>
+        [[nodiscard]] constexpr static std::size_t
+        type_index() noexcept { return meta::alternative_index_v<meta::stored_alternative_t<T>, Variant>; }
+
     private:
         friend std::ostream&
         operator<<(std::ostream& os, const match_type&) {
@@ -36,12 +36,19 @@
 #ifndef LINDADB_MATCH_VALUE_HXX
 #define LINDADB_MATCH_VALUE_HXX
 
+#include <compare>
 #include <concepts>
+#include <cstddef>
+#include <optional>
 #include <ostream>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <variant>
 
+#include <ldb/index/tree/key_search.hxx>
+#include <ldb/query/meta_finder.hxx>
+
 namespace ldb {
     template<class T>
     struct match_value {
@@ -58,32 +65,57 @@ namespace ldb {
         template<class... Args>
         [[nodiscard]] friend constexpr auto
         operator<=>(const std::variant<Args...>& value, const match_value& mv) noexcept(noexcept(std::declval<T>() == mv._field))
-            requires((std::same_as<T, Args> || ...))
+            requires((std::same_as<meta::stored_alternative_t<T>, Args> || ...))
         {
-            return std::visit([field = mv._field]<class V>(V&& val) {
-                if constexpr (std::same_as<std::remove_cvref_t<T>, std::remove_cvref_t<V>>) {
-                    return field <=> std::forward<V>(val);
-                }
-                else {
-                    auto t_idx = []<std::size_t... Is>(std::index_sequence<Is...>) {
-                        std::size_t idx{};
-                        (meta::finder(idx)(std::same_as<T, Args>, Is) || ...);
-                        return idx;
-                    }(std::make_index_sequence<sizeof...(Args)>());
-                    auto v_idx = []<std::size_t... Is>(std::index_sequence<Is...>) {
-                        std::size_t idx{};
-                        (meta::finder(idx)(std::same_as<V, Args>, Is) || ...);
-                        return idx;
-                    }(std::make_index_sequence<sizeof...(Args)>());
-                    return v_idx <=> t_idx;
-                }
-            },
-                              value);
+            using stored_type = meta::stored_alternative_t<T>;
+            using order_type = decltype(mv._field <=> std::declval<const stored_type&>());
+            // values of another alternative are ordered by their index, as by the variant itself
+            if (const auto* stored = std::get_if<stored_type>(&value);
+                stored) return static_cast<order_type>(0 <=> (mv._field <=> *stored));
+            return static_cast<order_type>(value.index() <=> match_value::type_index<std::variant<Args...>>());
+        }
+
+        /// Whether value holds this field. Cheaper than ordering: no field is
+        /// converted, and strings compare their lengths first.
+        template<class... Args>
+        [[nodiscard]] constexpr bool
+        matches(const std::variant<Args...>& value) const noexcept(noexcept(std::declval<T>() == _field))
+            requires((std::same_as<meta::stored_alternative_t<T>, Args> || ...))
+        {
+            const auto* stored = std::get_if<meta::stored_alternative_t<T>>(&value);
+            if (!stored) return false;
+            if constexpr (std::convertible_to<const T&, std::string_view>) {
+                return *stored == std::string_view(_field);
+            }
+            else if constexpr (std::equality_comparable_with<T, meta::stored_alternative_t<T>>) {
+                return _field == *stored;
+            }
+            else {
+                return std::is_eq(_field <=> *stored);
+            }
         }
 
         constexpr static std::true_type
         indexable() { return {}; }
 
+        /// The index of the alternative of Variant this matcher can match.
+        template<class Variant>
+        [[nodiscard]] constexpr static std::size_t
+        type_index() noexcept { return meta::alternative_index_v<meta::stored_alternative_t<T>, Variant>; }
+
+        /// The field as a key of a node of packed Variant keys.
+        template<class Variant>
+        [[nodiscard]] constexpr index::tree::packed_variant_key
+        packed_key() const noexcept {
+            using stored_type = meta::stored_alternative_t<T>;
+            if constexpr (std::integral<stored_type>) {
+                return {type_index<Variant>(), index::tree::helper::pack_integral(static_cast<stored_type>(_field))};
+            }
+            else {
+                return {type_index<Variant>(), std::nullopt};
+            }
+        }
+
     private:
         friend std::ostream&
         operator<<(std::ostream& os, const match_value& val) {
@@ -109,6 +141,27 @@ namespace ldb {
         constexpr static std::true_type
         indexable() { return {}; }
 
+        template<class Variant>
+        [[nodiscard]] constexpr std::size_t
+        type_index() const noexcept { return _field.index(); }
+
+        template<class Variant>
+        [[nodiscard]] constexpr index::tree::packed_variant_key
+        packed_key() const noexcept {
+            if constexpr (std::same_as<Variant, std::variant<Args...>>) {
+                if (!_field.valueless_by_exception()) {
+                    return index::tree::packed_keys<Variant, 1>::pack(_field);
+                }
+            }
+            return {std::variant_npos, std::nullopt};
+        }
+
+        template<class... Args2>
+        [[nodiscard]] constexpr bool
+        matches(const std::variant<Args2...>& value) const noexcept(noexcept(value == _field)) {
+            return value == _field;
+        }
+
     private:
         friend std::ostream&
         operator<<(std::ostream& os, const match_value& val) {
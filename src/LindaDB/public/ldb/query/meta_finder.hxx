@@ -38,8 +38,62 @@
 #define LINDADB_META_FINDER_HXX
 
 #include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <ldb/lv/linda_array.hxx>
+#include <ldb/lv/linda_string.hxx>
 
 namespace ldb::meta {
+    /**
+     * The alternative of linda_value a query field of type T is stored as. It is
+     * T itself, except for strings, which are stored as linda_strings.
+     */
+    template<class T>
+    struct stored_alternative {
+        using type = T;
+    };
+
+    template<>
+    struct stored_alternative<std::string> {
+        using type = lv::linda_string;
+    };
+
+    template<>
+    struct stored_alternative<std::string_view> {
+        using type = lv::linda_string;
+    };
+
+    /// Numeric vectors are stored as linda_arrays, and copied out on a match.
+    template<lv::linda_array_element T>
+    struct stored_alternative<std::vector<T>> {
+        using type = lv::linda_array<T>;
+    };
+
+    template<class T>
+    using stored_alternative_t = stored_alternative<T>::type;
+
+    /// The index of alternative T in Variant, or std::variant_npos if it is not one.
+    template<class T, class Variant>
+    struct alternative_index;
+
+    template<class T, class... Args>
+    struct alternative_index<T, std::variant<Args...>> {
+        constexpr const static std::size_t value = [] {
+            std::size_t idx = std::variant_npos;
+            std::size_t i = 0;
+            std::ignore = ((std::same_as<T, Args> ? (idx = i, true) : (++i, false)) || ...);
+            return idx;
+        }();
+    };
+
+    template<class T, class Variant>
+    constexpr const static auto alternative_index_v = alternative_index<T, Variant>::value;
+
     struct finder {
         explicit finder(size_t& idx) : idx(idx) { }
         std::size_t& idx;
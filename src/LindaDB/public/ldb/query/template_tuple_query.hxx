@@ -0,0 +1,147 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/public/ldb/query/template_tuple_query --
+ *   A query built from a tuple template received from another process: the
+ *   values of a tuple and a mask of the fields which are formals. A formal
+ *   field matches any value of the alternative its placeholder value holds.
+ */
+#ifndef LINDADB_TEMPLATE_TUPLE_QUERY_HXX
+#define LINDADB_TEMPLATE_TUPLE_QUERY_HXX
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <ldb/index/tree/index_query.hxx> // NOLINT(*-include-cleaner) actually used
+#include <ldb/lv/linda_tuple.hxx>
+#include <ldb/query/tuple_query_if.hxx>
+
+namespace ldb {
+    template<class IndexType>
+    struct template_tuple_query {
+        using value_type = IndexType::value_type;
+
+        /// Only the first this many fields can be formals.
+        constexpr const static std::size_t max_formal_fields = 64;
+
+        template_tuple_query(const template_tuple_query& cp) = default;
+        template_tuple_query&
+        operator=(const template_tuple_query& cp) = default;
+
+        template_tuple_query(template_tuple_query&& mv) noexcept = default;
+        template_tuple_query&
+        operator=(template_tuple_query&& mv) noexcept = default;
+
+        ~template_tuple_query() noexcept = default;
+
+        template_tuple_query(const lv::linda_tuple& values, std::uint64_t formals)
+             : _values(values),
+               _formals(formals) { }
+
+        /// The tuple_signature every tuple matching this query has: placeholders carry the types.
+        [[nodiscard]] std::uint64_t
+        signature() const noexcept { return _values.signature(); }
+
+        [[nodiscard]] bool
+        is_formal(std::size_t field_index) const noexcept {
+            return field_index < max_formal_fields
+                   && ((_formals >> field_index) & 1U) != 0U;
+        }
+
+        [[nodiscard]] field_match_type<value_type>
+        search_via_field(std::size_t field_index,
+                         const IndexType& db_index) const {
+            if (field_index >= _values.size() || is_formal(field_index)) return field_incomparable{};
+            if (const auto search_result = db_index.search(index::tree::value_lookup(_values[field_index], *this));
+                search_result.has_value()) return field_found(*search_result);
+            return field_not_found{};
+        }
+
+        [[nodiscard]] field_match_type<value_type>
+        remove_via_field(std::size_t field_index,
+                         IndexType& db_index) const {
+            if (field_index >= _values.size() || is_formal(field_index)) return field_incomparable{};
+            if (const auto search_result = db_index.remove(index::tree::value_lookup(_values[field_index], *this));
+                search_result.has_value()) return field_found(*search_result);
+            return field_not_found{};
+        }
+
+    private:
+        lv::linda_tuple _values;
+        std::uint64_t _formals;
+
+        friend constexpr std::partial_ordering
+        operator<=>(const lv::linda_tuple& lhs, const template_tuple_query& query) {
+            const lv::linda_tuple& rhs = query._values;
+            if (lhs.size() != rhs.size()) return lhs.size() <=> rhs.size();
+            for (std::size_t i = 0; i < rhs.size(); ++i) {
+                const auto cmp_result = query.is_formal(i)
+                                               ? std::partial_ordering(lhs[i].index() <=> rhs[i].index())
+                                               : lhs[i] <=> rhs[i];
+                if (std::is_neq(cmp_result)) return cmp_result;
+            }
+            return std::strong_ordering::equal;
+        }
+
+        template<meta::tuple_wrapper TupleWrapper>
+        friend constexpr std::partial_ordering
+        operator<=>(const TupleWrapper& tw, const template_tuple_query& query) {
+            return std::as_const(*tw) <=> query;
+        }
+
+        friend constexpr bool
+        operator==(const lv::linda_tuple& lt, const template_tuple_query& query) {
+            const lv::linda_tuple& rhs = query._values;
+            if (lt.size() != rhs.size()) return false;
+            if (lt.signature() != rhs.signature()) return false;
+            for (std::size_t i = 0; i < rhs.size(); ++i) {
+                if (query.is_formal(i)) {
+                    if (lt[i].index() != rhs[i].index()) return false;
+                }
+                else if (lt[i] != rhs[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<meta::tuple_wrapper TupleWrapper>
+        friend constexpr bool
+        operator==(const TupleWrapper& tw, const template_tuple_query& query) {
+            return std::as_const(*tw) == query;
+        }
+    };
+}
+
+#endif
@@ -31,16 +31,22 @@
  * Originally created: 2024-01-15.
  *
  * src/LindaDB/public/ldb/query/tuple_query --
- *   
+ *   A type erased query over an index. Small queries, like the ones built
+ *   for each in/rd call, are stored in an inline buffer; larger ones go to
+ *   the heap.
  */
 #ifndef LINDADB_TUPLE_QUERY_HXX
 #define LINDADB_TUPLE_QUERY_HXX
 
+#include <bit>
 #include <cassert>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <variant>
 
 #include <ldb/index/tree/impl/avl2/avl2_tree.hxx>
@@ -53,6 +59,10 @@ namespace ldb {
     class tuple_query final {
         using internal_value_type = IndexType::value_type;
 
+        /// Bytes available for storing a query without allocation: enough for
+        /// a manual_fields_query of a handful of fields.
+        constexpr const static std::size_t inline_capacity = 12 * sizeof(void*);
+
         struct query_concept {
             query_concept(const query_concept& cp) = delete;
             query_concept&
@@ -75,8 +85,22 @@ namespace ldb {
             [[nodiscard]] virtual std::partial_ordering
             do_compare(const lv::linda_tuple& tuple) const = 0;
 
-            [[nodiscard]] virtual std::unique_ptr<query_concept>
-            clone() const = 0;
+            [[nodiscard]] virtual bool
+            do_matches(const lv::linda_tuple& tuple) const = 0;
+
+            [[nodiscard]] virtual std::uint64_t
+            do_match_block(const lv::linda_tuple* tuples, std::uint64_t candidates) const = 0;
+
+            [[nodiscard]] virtual std::uint64_t
+            do_signature() const = 0;
+
+            /// Copies the query into buffer if it fits there, or onto the heap.
+            [[nodiscard]] virtual query_concept*
+            clone_into(std::byte* buffer) const = 0;
+
+            /// Moves an inline stored query into buffer.
+            [[nodiscard]] virtual query_concept*
+            move_into(std::byte* buffer) noexcept = 0;
 
         protected:
             query_concept() noexcept = default;
@@ -101,18 +125,117 @@ namespace ldb {
                 return tuple <=> query_impl;
             }
 
-            [[nodiscard]] std::unique_ptr<query_concept>
-            clone() const override {
-                return std::make_unique<query_model<Query>>(query_impl);
+            [[nodiscard]] bool
+            do_matches(const lv::linda_tuple& tuple) const override {
+                return tuple == query_impl;
+            }
+
+            [[nodiscard]] std::uint64_t
+            do_match_block(const lv::linda_tuple* tuples, std::uint64_t candidates) const override {
+                const auto signature = do_signature();
+                std::uint64_t matches = 0;
+                for (; candidates != 0; candidates &= candidates - 1) {
+                    const auto idx = std::countr_zero(candidates);
+                    const auto& tuple = tuples[idx];
+                    if (signature != 0 && tuple.signature() != signature) continue;
+                    if (accepts(tuple)) matches |= std::uint64_t{1} << idx;
+                }
+                return matches;
+            }
+
+            [[nodiscard]] bool
+            accepts(const lv::linda_tuple& tuple) const {
+                if constexpr (requires { { query_impl.accepts(tuple) } -> std::convertible_to<bool>; }) {
+                    return query_impl.accepts(tuple);
+                }
+                else {
+                    return tuple == query_impl;
+                }
+            }
+
+            [[nodiscard]] std::uint64_t
+            do_signature() const override {
+                if constexpr (requires { { query_impl.signature() } -> std::convertible_to<std::uint64_t>; }) {
+                    return query_impl.signature();
+                }
+                return 0;
             }
 
-            explicit query_model(Query query_impl)
+            [[nodiscard]] query_concept*
+            clone_into(std::byte* buffer) const override {
+                if constexpr (fits_inline<query_model>) {
+                    return ::new (buffer) query_model(query_impl);
+                }
+                else {
+                    std::ignore = buffer;
+                    return new query_model(query_impl);
+                }
+            }
+
+            [[nodiscard]] query_concept*
+            move_into(std::byte* buffer) noexcept override {
+                if constexpr (fits_inline<query_model>) {
+                    return ::new (buffer) query_model(std::move(query_impl));
+                }
+                else {
+                    // heap stored queries are moved by their pointer
+                    std::ignore = buffer;
+                    std::unreachable();
+                }
+            }
+
+            using query_type = Query;
+
+            explicit query_model(Query query_impl) noexcept(std::is_nothrow_move_constructible_v<Query>)
                  : query_impl(std::move(query_impl)) { }
 
             Query query_impl;
         };
 
-        std::unique_ptr<query_concept> _impl{};
+        template<class Model>
+        constexpr const static bool fits_inline = sizeof(Model) <= inline_capacity
+                                                  && alignof(Model) <= alignof(std::max_align_t)
+                                                  && std::is_nothrow_constructible_v<Model, typename Model::query_type&&>;
+
+        alignas(std::max_align_t) std::byte _buffer[inline_capacity];
+        query_concept* _impl = nullptr;
+        bool _inline = false;
+        // zero if the underlying query cannot tell the signature of its matches
+        std::uint64_t _signature{};
+
+        void
+        copy_from(const tuple_query& cp) {
+            if (!cp._impl) return;
+            _impl = cp._impl->clone_into(_buffer);
+            _inline = cp._inline;
+            _signature = cp._signature;
+        }
+
+        void
+        move_from(tuple_query& mv) noexcept {
+            if (!mv._impl) return;
+            _inline = mv._inline;
+            _signature = mv._signature;
+            if (mv._inline) {
+                _impl = mv._impl->move_into(_buffer);
+                mv.reset();
+            }
+            else {
+                _impl = std::exchange(mv._impl, nullptr);
+            }
+        }
+
+        void
+        reset() noexcept {
+            if (_inline) {
+                std::destroy_at(_impl);
+            }
+            else {
+                delete _impl;
+            }
+            _impl = nullptr;
+            _inline = false;
+        }
 
         friend constexpr std::partial_ordering
         operator<=>(const lv::linda_tuple& lt, const tuple_query& query) {
@@ -127,13 +250,15 @@ namespace ldb {
 
         friend constexpr bool
         operator==(const lv::linda_tuple& lt, const tuple_query& query) {
-            return std::is_eq(lt <=> query);
+            // rejects most non-matches of a scan without the virtual call
+            if (query._signature != 0 && lt.signature() != query._signature) return false;
+            return query._impl->do_matches(lt);
         }
 
         template<meta::tuple_wrapper TupleWrapper>
         friend constexpr bool
         operator==(const TupleWrapper& tw, const tuple_query& query) {
-            return std::is_eq(*tw <=> query);
+            return *tw == query;
         }
 
     public:
@@ -141,22 +266,62 @@ namespace ldb {
 
         template<class Query>
         explicit(false) tuple_query(Query&& query)
-            requires(!std::same_as<Query, tuple_query>)
-             : _impl(std::make_unique<query_model<Query>>(std::forward<Query>(query))) { }
+            requires(!std::same_as<std::remove_cvref_t<Query>, tuple_query>)
+        {
+            using model_type = query_model<std::remove_cvref_t<Query>>;
+            if constexpr (fits_inline<model_type>) {
+                _impl = ::new (_buffer) model_type(std::forward<Query>(query));
+                _inline = true;
+            }
+            else {
+                _impl = new model_type(std::forward<Query>(query));
+            }
+            _signature = _impl->do_signature();
+        }
 
-        tuple_query(const tuple_query& cp)
-             : _impl(cp._impl->clone()) { }
+        tuple_query(const tuple_query& cp) {
+            copy_from(cp);
+        }
         tuple_query&
         operator=(const tuple_query& cp) {
-            if (this != &cp) _impl = cp._impl->clone();
+            if (this != &cp) {
+                reset();
+                copy_from(cp);
+            }
             return *this;
         }
 
-        tuple_query(tuple_query&& mv) noexcept = default;
+        tuple_query(tuple_query&& mv) noexcept {
+            move_from(mv);
+        }
         tuple_query&
-        operator=(tuple_query&& mv) noexcept = default;
+        operator=(tuple_query&& mv) noexcept {
+            if (this != &mv) {
+                reset();
+                move_from(mv);
+            }
+            return *this;
+        }
+
+        ~tuple_query() {
+            reset();
+        }
+
+        /**
+         * Matches a block of tuples with a single dispatch to the underlying
+         * query: bit i of the result is set if bit i of candidates is, and
+         * tuples[i] matches. Formals are not written, a match found this way
+         * is to be confirmed with operator==, which writes them.
+         */
+        [[nodiscard]] std::uint64_t
+        match_block(const lv::linda_tuple* tuples, std::uint64_t candidates) const {
+            assert_that(_impl);
+            return _impl->do_match_block(tuples, candidates);
+        }
 
-        ~tuple_query() = default;
+        /// Whether the query is stored without a heap allocation.
+        [[nodiscard]] bool
+        stored_inline() const noexcept { return _inline; }
 
         [[nodiscard]] field_match_type<internal_value_type>
         search_on_index(std::size_t field_index,
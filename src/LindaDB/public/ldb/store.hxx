@@ -47,18 +47,20 @@
 #include <shared_mutex>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <variant>
 
 #include <ldb/bcast/broadcast.hxx>
 #include <ldb/bcast/broadcaster.hxx>
 #include <ldb/bcast/null_broadcast.hxx>
 #include <ldb/data/chunked_list.hxx>
+#include <ldb/data/tuple_id.hxx>
 #include <ldb/index/tree/impl/avl2/avl2_tree.hxx>
 #include <ldb/index/tree/index_query.hxx>
 #include <ldb/lv/linda_tuple.hxx>
 #include <ldb/lv/linda_value.hxx>
-#include <ldb/query/concrete_tuple_query.hxx>
 #include <ldb/query/tuple_query.hxx>
 
 #include "ldb/query/make_matcher.hxx"
@@ -73,24 +75,11 @@ namespace ldb {
 
         void
         out(const lv::linda_tuple& tuple) {
+            const auto id = _id_source.next();
+            const auto await_handle = broadcast_insert(_broadcast, id, tuple);
             {
                 std::scoped_lock<std::shared_mutex> lck(_header_mtx);
-                if (const auto it = _removed_later.find(tuple);
-                    it != _removed_later.end()) {
-                    _removed_later.erase(it);
-                    return;
-                }
-            }
-            const auto await_handle = broadcast_insert(_broadcast, tuple);
-            auto new_it = _data.push_back(tuple);
-
-            {
-                std::scoped_lock<std::shared_mutex> lck(_header_mtx);
-                for (std::size_t i = 0;
-                     i < _header_indices.size() && i < tuple.size();
-                     ++i) {
-                    _header_indices[i].insert(tuple[i], new_it);
-                }
+                insert_unguarded(id, tuple);
             }
 
             await(await_handle);
@@ -126,7 +115,7 @@ namespace ldb {
         inp(Args&&... args)
             requires((
                    (lv::is_linda_value_v<std::remove_cvref_t<Args>>
-                    || meta::is_matcher_type_v<Args>)
+                    || meta::is_matcher_type_v<std::remove_cvref_t<Args>>)
                    && ...))
         {
             using index_type = index::tree::avl2_tree<lv::linda_value,
@@ -139,7 +128,7 @@ namespace ldb {
         in(Args&&... args)
             requires((
                    (lv::is_linda_value_v<std::remove_cvref_t<Args>>
-                    || meta::is_matcher_type_v<Args>)
+                    || meta::is_matcher_type_v<std::remove_cvref_t<Args>>)
                    && ...))
         {
             using index_type = index::tree::avl2_tree<lv::linda_value,
@@ -152,7 +141,7 @@ namespace ldb {
         rdp(Args&&... args)
             requires((
                    (lv::is_linda_value_v<std::remove_cvref_t<Args>>
-                    || meta::is_matcher_type_v<Args>)
+                    || meta::is_matcher_type_v<std::remove_cvref_t<Args>>)
                    && ...))
         {
             using index_type = index::tree::avl2_tree<lv::linda_value,
@@ -165,7 +154,7 @@ namespace ldb {
         rd(Args&&... args)
             requires((
                    (lv::is_linda_value_v<std::remove_cvref_t<Args>>
-                    || meta::is_matcher_type_v<Args>)
+                    || meta::is_matcher_type_v<std::remove_cvref_t<Args>>)
                    && ...))
         {
             using index_type = index::tree::avl2_tree<lv::linda_value,
@@ -179,39 +168,33 @@ namespace ldb {
             _broadcast = std::forward<Bcast>(bcast);
         }
 
+        /// Sets the node the ids of the tuples inserted here name as their origin.
         void
-        out_nosignal(const lv::linda_tuple& tuple) {
-            {
-                std::scoped_lock<std::shared_mutex> lck(_header_mtx);
-                if (const auto it = _removed_later.find(tuple);
-                    it != _removed_later.end()) {
-                    _removed_later.erase(it);
-                    return;
-                }
-            }
-            auto new_it = _data.push_back(tuple);
+        set_origin(std::uint32_t origin) noexcept {
+            _id_source.set_origin(origin);
+        }
 
+        /// Inserts a tuple inserted by another node, under the id it got there.
+        void
+        out_nosignal(data::tuple_id id, const lv::linda_tuple& tuple) {
             {
                 std::scoped_lock<std::shared_mutex> lck(_header_mtx);
-                for (std::size_t i = 0;
-                     i < _header_indices.size() && i < tuple.size();
-                     ++i) {
-                    _header_indices[i].insert(tuple[i], new_it);
-                }
+                if (!insert_unguarded(id, tuple)) return;
             }
-
             notify_readers();
         }
 
+        /// Removes a tuple removed by another node. If its insertion has not
+        /// arrived yet, it is dropped when it does.
         void
-        remove_nosignal(const lv::linda_tuple& tuple) {
-            using index_type = index::tree::avl2_tree<lv::linda_value,
-                                                      pointer_type>;
-            const auto removed = retrieve_weak(concrete_tuple_query<index_type>(tuple),
-                                               std::mem_fn(&store::read_and_remove_nosignal));
-            if (!removed) {
-                _removed_later.insert(tuple);
+        remove_nosignal(data::tuple_id id) {
+            std::scoped_lock<std::shared_mutex> lck(_header_mtx);
+            if (const auto it = _handles.find(id);
+                it != _handles.end()) {
+                std::ignore = erase_unguarded(it->second, _header_indices.size());
+                return;
             }
+            _removed_later.insert(id);
         }
 
     private:
@@ -310,41 +293,56 @@ namespace ldb {
                 const auto result = query.remove_on_index(i, _header_indices[i]);
                 if (const auto found = std::visit(query_result_visitor{}, result);
                     found) {
-                    const auto it = *found;
                     auto tuple = **found; // not-const to allow move from return
-                    auto bcast = broadcast_delete(_broadcast, tuple);
-                    for (std::size_t j = 0; j < _header_indices.size(); ++j) {
-                        if (j == i) continue;
-                        std::ignore = _header_indices[i].remove(index::tree::value_lookup(tuple[i], it));
-                    }
-                    _data.erase(it);
-                    await(bcast);
+                    const auto id = erase_unguarded(*found, i);
+                    await(broadcast_delete(_broadcast, id));
                     return tuple;
                 }
             }
-            const auto res = _data.locked_destructive_find(query);
-            if (res) await(broadcast_delete(_broadcast, *res));
-            return res;
+            if (const auto found = _data.locked_find_iterator(query)) {
+                auto tuple = **found;
+                const auto id = erase_unguarded(*found, _header_indices.size());
+                await(broadcast_delete(_broadcast, id));
+                return tuple;
+            }
+            return std::nullopt;
         }
 
-        std::optional<lv::linda_tuple>
-        read_and_remove_nosignal(const query_type& query) {
-            const std::scoped_lock<std::shared_mutex> lck(_header_mtx);
-            for (std::size_t i = 0; i < _header_indices.size(); ++i) {
-                const auto result = query.remove_on_index(i, _header_indices[i]);
-                if (const auto found = std::visit(query_result_visitor{}, result);
-                    found) {
-                    const auto it = *found;
-                    auto tuple = **found; // not-const to allow move from return
-                    for (std::size_t j = 0; j < _header_indices.size(); ++j) {
-                        if (j == i) continue;
-                        std::ignore = _header_indices[i].remove(index::tree::value_lookup(tuple[i], it));
-                    }
-                    _data.erase(it);
-                    return tuple;
-                }
+        /// Stores a tuple under id unless its removal arrived first; needs the exclusive header lock.
+        bool
+        insert_unguarded(data::tuple_id id, const lv::linda_tuple& tuple) {
+            if (_removed_later.erase(id) > 0) return false;
+
+            auto new_it = _data.push_back(tuple);
+            for (std::size_t i = 0;
+                 i < _header_indices.size() && i < tuple.size();
+                 ++i) {
+                _header_indices[i].insert(tuple[i], new_it);
             }
-            return _data.locked_destructive_find(query);
+            _handles.emplace(id, new_it);
+            _ids.emplace(new_it, id);
+            return true;
+        }
+
+        /// Erases the tuple at it from the data and the indices, except the
+        /// one at removed_index it was already taken from; returns its id.
+        /// Needs the exclusive header lock.
+        data::tuple_id
+        erase_unguarded(pointer_type it, std::size_t removed_index) {
+            const auto& tuple = std::as_const(*it);
+            for (std::size_t j = 0;
+                 j < _header_indices.size() && j < tuple.size();
+                 ++j) {
+                if (j == removed_index) continue;
+                std::ignore = _header_indices[j].remove(index::tree::value_lookup(tuple[j], it));
+            }
+
+            const auto id_it = _ids.find(it);
+            const auto id = id_it->second;
+            _ids.erase(id_it);
+            _handles.erase(id);
+            _data.erase(it);
+            return id;
         }
 
         [[gnu::always_inline]] [[nodiscard]] bool
@@ -366,8 +364,16 @@ namespace ldb {
         mutable std::mutex _read_mtx;
         mutable std::condition_variable _wait_read;
 
+        struct pointer_hash {
+            std::size_t
+            operator()(const pointer_type& ptr) const noexcept { return ptr.hash(); }
+        };
+
         mutable std::shared_mutex _header_mtx;
-        std::unordered_set<lv::linda_tuple> _removed_later{};
+        data::tuple_id_source _id_source{};
+        std::unordered_map<data::tuple_id, pointer_type> _handles{};
+        std::unordered_map<pointer_type, data::tuple_id, pointer_hash> _ids{};
+        std::unordered_set<data::tuple_id> _removed_later{};
         std::array<index::tree::avl2_tree<lv::linda_value, pointer_type>, 2> _header_indices{};
         broadcast _broadcast = null_broadcast{};
         storage_type _data{};
@@ -0,0 +1,460 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/public/ldb/typed_store --
+ *   A tuple space for tuples of a single, compile-time known shape. Rows are
+ *   kept as plain std::tuple<Ts...>s, column by column in fixed-size chunks,
+ *   the leading fields are indexed in ordered sets of their own type, and
+ *   templates are matched field-by-field with the fields' own operator==, so
+ *   no linda_value variant is ever visited on the local paths.
+ *
+ *   The space still talks to the rest of the cluster through the broadcaster
+ *   concept: rows are converted to linda_tuples only when they are broadcast,
+ *   and received linda_tuples are converted back.
+ */
+#ifndef LINDADB_TYPED_STORE_HXX
+#define LINDADB_TYPED_STORE_HXX
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <ldb/bcast/broadcast.hxx>
+#include <ldb/bcast/broadcaster.hxx>
+#include <ldb/bcast/null_broadcast.hxx>
+#include <ldb/data/tuple_id.hxx>
+#include <ldb/lv/linda_tuple.hxx>
+#include <ldb/lv/linda_value.hxx>
+#include <ldb/query/match_type.hxx>
+#include <ldb/query/meta_finder.hxx>
+
+namespace ldb {
+    namespace meta {
+        /// Field types a typed_store can hold: ones with a linda_value representation.
+        template<class T>
+        concept typed_field = alternative_index_v<stored_alternative_t<T>, lv::linda_value> != std::variant_npos
+                              && std::equality_comparable<T>;
+
+        /// A template field that binds the value of a matched field.
+        template<class Arg, class Field>
+        concept typed_formal = std::same_as<std::remove_cvref_t<Arg>, match_type<Field>>;
+
+        /// A template field that must compare equal to the matched field.
+        template<class Arg, class Field>
+        concept typed_actual = !typed_formal<Arg, Field>
+                               && requires(const Field& field, const Arg& arg) {
+                                      { field == arg } -> std::convertible_to<bool>;
+                                  };
+
+        template<class Arg, class Field>
+        concept typed_template_field = typed_formal<Arg, Field> || typed_actual<Arg, Field>;
+    }
+
+    template<meta::typed_field... Ts>
+        requires(sizeof...(Ts) > 0)
+    class typed_store final {
+    public:
+        using row_type = std::tuple<Ts...>;
+
+        /// Rows per columnar chunk.
+        constexpr const static std::size_t chunk_rows = 256;
+        /// The number of leading fields that are indexed, like the headers of store.
+        constexpr const static std::size_t indexed_fields = std::min<std::size_t>(2, sizeof...(Ts));
+
+        void
+        out(row_type row) {
+            const auto id = _id_source.next();
+            const auto await_handle = broadcast_insert(_broadcast, id, to_linda_tuple(row));
+            {
+                std::scoped_lock<std::shared_mutex> lck(_mtx);
+                if (!consume_removed_later(id)) insert_row(id, std::move(row));
+            }
+            await(await_handle);
+            _wait_read.notify_all();
+        }
+
+        template<class... Args>
+        std::optional<row_type>
+        rdp(const Args&... args) const
+            requires(sizeof...(Args) == sizeof...(Ts)
+                     && (meta::typed_template_field<Args, Ts> && ...))
+        {
+            std::shared_lock<std::shared_mutex> lck(_mtx);
+            return read(args...);
+        }
+
+        template<class... Args>
+        row_type
+        rd(const Args&... args) const
+            requires(sizeof...(Args) == sizeof...(Ts)
+                     && (meta::typed_template_field<Args, Ts> && ...))
+        {
+            std::shared_lock<std::shared_mutex> lck(_mtx);
+            std::optional<row_type> ret;
+            _wait_read.wait(lck, [&] { return (ret = read(args...)).has_value(); });
+            return std::move(*ret);
+        }
+
+        template<class... Args>
+        std::optional<row_type>
+        inp(const Args&... args)
+            requires(sizeof...(Args) == sizeof...(Ts)
+                     && (meta::typed_template_field<Args, Ts> && ...))
+        {
+            std::unique_lock<std::shared_mutex> lck(_mtx);
+            return read_and_remove(args...);
+        }
+
+        template<class... Args>
+        row_type
+        in(const Args&... args)
+            requires(sizeof...(Args) == sizeof...(Ts)
+                     && (meta::typed_template_field<Args, Ts> && ...))
+        {
+            std::unique_lock<std::shared_mutex> lck(_mtx);
+            std::optional<row_type> ret;
+            _wait_read.wait(lck, [&] { return (ret = read_and_remove(args...)).has_value(); });
+            return std::move(*ret);
+        }
+
+        template<broadcaster Bcast>
+        void
+        set_broadcast(Bcast&& bcast) {
+            _broadcast = std::forward<Bcast>(bcast);
+        }
+
+        /// Sets the node the ids of the rows inserted here name as their origin.
+        void
+        set_origin(std::uint32_t origin) noexcept {
+            _id_source.set_origin(origin);
+        }
+
+        /// Inserts a tuple received from another node. Tuples of another
+        /// shape are not stored, only their ids are remembered, so their
+        /// removal is not mistaken for one that arrived early.
+        void
+        out_nosignal(data::tuple_id id, const lv::linda_tuple& tuple) {
+            auto row = from_linda_tuple(tuple);
+            {
+                std::scoped_lock<std::shared_mutex> lck(_mtx);
+                if (consume_removed_later(id)) return;
+                if (!row) {
+                    _foreign_ids.insert(id);
+                    return;
+                }
+                insert_row(id, std::move(*row));
+            }
+            _wait_read.notify_all();
+        }
+
+        /// Removes a tuple removed by another node.
+        void
+        remove_nosignal(data::tuple_id id) {
+            std::scoped_lock<std::shared_mutex> lck(_mtx);
+            if (const auto it = _rows_by_id.find(id);
+                it != _rows_by_id.end()) {
+                std::ignore = remove_row(it->second);
+                return;
+            }
+            if (_foreign_ids.erase(id) > 0) return;
+            _removed_later.insert(id);
+        }
+
+        [[nodiscard]] std::size_t
+        size() const {
+            std::shared_lock<std::shared_mutex> lck(_mtx);
+            return _size;
+        }
+
+        [[nodiscard]] static lv::linda_tuple
+        to_linda_tuple(const row_type& row) {
+            return std::apply([](const auto&... fields) {
+                return lv::linda_tuple(lv::make_linda_value(fields)...);
+            },
+                              row);
+        }
+
+        /// The row of a linda_tuple, if the tuple has the shape of this space.
+        [[nodiscard]] static std::optional<row_type>
+        from_linda_tuple(const lv::linda_tuple& tuple) {
+            if (tuple.size() != sizeof...(Ts)) return std::nullopt;
+            return [&tuple]<std::size_t... Is>(std::index_sequence<Is...>) -> std::optional<row_type> {
+                const std::tuple found{std::get_if<meta::stored_alternative_t<Ts>>(&tuple[Is])...};
+                if (!(std::get<Is>(found) && ...)) return std::nullopt;
+                return row_type(static_cast<Ts>(*std::get<Is>(found))...);
+            }(std::index_sequence_for<Ts...>());
+        }
+
+    private:
+        template<std::size_t I>
+        using field_type = std::tuple_element_t<I, row_type>;
+
+        struct chunk {
+            std::tuple<std::array<Ts, chunk_rows>...> columns{};
+            std::array<data::tuple_id, chunk_rows> ids{};
+            // bytes instead of a bitset, so filtering a column vectorizes
+            std::array<std::uint8_t, chunk_rows> live{};
+        };
+
+        template<std::size_t... Is>
+        static auto
+        make_indices(std::index_sequence<Is...>)
+               -> std::tuple<std::set<std::pair<field_type<Is>, std::size_t>>...>;
+
+        using indices_type = decltype(make_indices(std::make_index_sequence<indexed_fields>()));
+
+        template<std::size_t I>
+        [[nodiscard]] auto&
+        column(std::size_t row) const noexcept {
+            return std::get<I>(_chunks[row / chunk_rows]->columns)[row % chunk_rows];
+        }
+
+        void
+        insert_row(data::tuple_id id, row_type&& row) {
+            std::size_t at = _end;
+            if (_free_rows.empty()) {
+                if (_end % chunk_rows == 0) _chunks.push_back(std::make_unique<chunk>());
+                ++_end;
+            }
+            else {
+                at = _free_rows.back();
+                _free_rows.pop_back();
+            }
+
+            auto& chk = *_chunks[at / chunk_rows];
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                ((std::get<Is>(chk.columns)[at % chunk_rows] = std::move(std::get<Is>(row))), ...);
+            }(std::index_sequence_for<Ts...>());
+            chk.live[at % chunk_rows] = 1;
+            chk.ids[at % chunk_rows] = id;
+            _rows_by_id.emplace(id, at);
+
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                (std::get<Is>(_indices).emplace(column<Is>(at), at), ...);
+            }(std::make_index_sequence<indexed_fields>());
+            ++_size;
+        }
+
+        /// Removes the row at at; returns its id.
+        data::tuple_id
+        remove_row(std::size_t at) {
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                (std::get<Is>(_indices).erase(std::pair(column<Is>(at), at)), ...);
+            }(std::make_index_sequence<indexed_fields>());
+
+            auto& chk = *_chunks[at / chunk_rows];
+            chk.live[at % chunk_rows] = 0;
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                // drop what the fields own, like the storage of long strings
+                ((std::get<Is>(chk.columns)[at % chunk_rows] = Ts{}), ...);
+            }(std::index_sequence_for<Ts...>());
+            _free_rows.push_back(at);
+            --_size;
+
+            const auto id = chk.ids[at % chunk_rows];
+            _rows_by_id.erase(id);
+            return id;
+        }
+
+        [[nodiscard]] row_type
+        row_at(std::size_t at) const {
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return row_type(column<Is>(at)...);
+            }(std::index_sequence_for<Ts...>());
+        }
+
+        template<class... Args>
+        [[nodiscard]] bool
+        row_matches(std::size_t at, const Args&... args) const {
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return (field_matches<Is>(at, args) && ...);
+            }(std::index_sequence_for<Ts...>());
+        }
+
+        template<std::size_t I, class Arg>
+        [[nodiscard]] bool
+        field_matches(std::size_t at, const Arg& arg) const {
+            if constexpr (meta::typed_formal<Arg, field_type<I>>) {
+                std::ignore = at;
+                return true;
+            }
+            else {
+                return column<I>(at) == arg;
+            }
+        }
+
+        template<class... Args>
+        void
+        bind_formals(std::size_t at, const Args&... args) const {
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                (bind_formal<Is>(at, args), ...);
+            }(std::index_sequence_for<Ts...>());
+        }
+
+        template<std::size_t I, class Arg>
+        void
+        bind_formal(std::size_t at, const Arg& arg) const {
+            if constexpr (meta::typed_formal<Arg, field_type<I>>) {
+                *arg.target() = column<I>(at);
+            }
+        }
+
+        template<class... Args>
+        [[nodiscard]] std::optional<std::size_t>
+        find_row(const Args&... args) const {
+            std::optional<std::size_t> found;
+            const auto used_index = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return (search_index<Is>(found, args...) || ...);
+            }(std::make_index_sequence<indexed_fields>());
+            if (used_index) return found;
+            return scan(args...);
+        }
+
+        /// Looks up the row via the index of field I, if the template gives a value for it.
+        template<std::size_t I, class... Args>
+        [[nodiscard]] bool
+        search_index(std::optional<std::size_t>& found, const Args&... args) const {
+            const auto& arg = std::get<I>(std::forward_as_tuple(args...));
+            if constexpr (meta::typed_formal<decltype(arg), field_type<I>>) {
+                std::ignore = found;
+                return false;
+            }
+            else {
+                const auto& index = std::get<I>(_indices);
+                const field_type<I> key(arg);
+                for (auto it = index.lower_bound(std::pair(key, std::size_t{}));
+                     it != index.end() && it->first == key;
+                     ++it) {
+                    if (row_matches(it->second, args...)) {
+                        found = it->second;
+                        break;
+                    }
+                }
+                return true;
+            }
+        }
+
+        template<class... Args>
+        [[nodiscard]] std::optional<std::size_t>
+        scan(const Args&... args) const {
+            for (std::size_t c = 0; c < _chunks.size(); ++c) {
+                const auto& chk = *_chunks[c];
+                auto candidates = chk.live;
+                [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                    (filter_column<Is>(chk, candidates, args), ...);
+                }(std::index_sequence_for<Ts...>());
+
+                const auto hit = std::ranges::find(candidates, std::uint8_t{1});
+                if (hit != candidates.end()) {
+                    return c * chunk_rows + static_cast<std::size_t>(hit - candidates.begin());
+                }
+            }
+            return std::nullopt;
+        }
+
+        template<std::size_t I, class Arg>
+        static void
+        filter_column(const chunk& chk,
+                      std::array<std::uint8_t, chunk_rows>& candidates,
+                      const Arg& arg) {
+            if constexpr (!meta::typed_formal<Arg, field_type<I>>) {
+                const auto& col = std::get<I>(chk.columns);
+                for (std::size_t i = 0; i < chunk_rows; ++i) {
+                    if constexpr (std::is_arithmetic_v<field_type<I>>) {
+                        candidates[i] &= static_cast<std::uint8_t>(col[i] == arg);
+                    }
+                    else {
+                        if (candidates[i]) candidates[i] = static_cast<std::uint8_t>(col[i] == arg);
+                    }
+                }
+            }
+        }
+
+        template<class... Args>
+        [[nodiscard]] std::optional<row_type>
+        read(const Args&... args) const {
+            const auto found = find_row(args...);
+            if (!found) return std::nullopt;
+            bind_formals(*found, args...);
+            return row_at(*found);
+        }
+
+        template<class... Args>
+        [[nodiscard]] std::optional<row_type>
+        read_and_remove(const Args&... args) {
+            const auto found = find_row(args...);
+            if (!found) return std::nullopt;
+            bind_formals(*found, args...);
+            auto row = row_at(*found);
+            const auto id = remove_row(*found);
+            await(broadcast_delete(_broadcast, id));
+            return row;
+        }
+
+        [[nodiscard]] bool
+        consume_removed_later(data::tuple_id id) {
+            return _removed_later.erase(id) > 0;
+        }
+
+        mutable std::shared_mutex _mtx;
+        mutable std::condition_variable_any _wait_read;
+
+        std::vector<std::unique_ptr<chunk>> _chunks{};
+        std::vector<std::size_t> _free_rows{};
+        std::size_t _end = 0;
+        std::size_t _size = 0;
+        indices_type _indices{};
+        data::tuple_id_source _id_source{};
+        std::unordered_map<data::tuple_id, std::size_t> _rows_by_id{};
+        std::unordered_set<data::tuple_id> _removed_later{};
+        // ids of tuples of another shape, received from other nodes
+        std::unordered_set<data::tuple_id> _foreign_ids{};
+        broadcast _broadcast = null_broadcast{};
+    };
+}
+
+#endif
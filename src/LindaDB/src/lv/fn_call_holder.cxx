@@ -40,6 +40,8 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <iterator>
 #include <memory>
 #include <string>
@@ -51,34 +53,56 @@
 #include <ldb/lv/linda_tuple.hxx>
 #include <ldb/lv/tuple_builder.hxx>
 
+struct ldb::lv::fn_call_holder::call_data {
+    std::atomic<std::size_t> refs;
+    std::string fn_name;
+    std::unique_ptr<linda_tuple> args;
+};
+
 ldb::lv::fn_call_holder::fn_call_holder(std::string fn_name, std::unique_ptr<linda_tuple>&& tuple)
-     : _fn_name(std::move(fn_name)), _args(std::move(tuple)) {
-    assert_that(_args, "fn_call_holder: null may not be passed as the args tuple");
+     : _call(new call_data{.refs = 1, .fn_name = std::move(fn_name), .args = std::move(tuple)}) {
+    assert_that(_call->args, "fn_call_holder: null may not be passed as the args tuple");
 }
 
-ldb::lv::fn_call_holder::~fn_call_holder() = default;
+ldb::lv::fn_call_holder::~fn_call_holder() {
+    if (_call && _call->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete _call;
+}
 
 ldb::lv::fn_call_holder::fn_call_holder(const fn_call_holder& cp)
-     : _fn_name(cp._fn_name),
-       _args(cp._args->clone()) { }
+     : _call(cp._call) {
+    if (_call) _call->refs.fetch_add(1, std::memory_order_relaxed);
+}
 
 ldb::lv::fn_call_holder&
 ldb::lv::fn_call_holder::operator=(const ldb::lv::fn_call_holder& cp) {
     if (&cp == this) return *this;
-    _fn_name = cp._fn_name;
-    _args = cp._args->clone();
+    fn_call_holder tmp(cp);
+    std::swap(_call, tmp._call);
     return *this;
 }
 
+const std::string&
+ldb::lv::fn_call_holder::fn_name() const noexcept {
+    static const std::string moved_from_name;
+    if (!_call) return moved_from_name;
+    return _call->fn_name;
+}
+
+const ldb::lv::linda_tuple&
+ldb::lv::fn_call_holder::args() const noexcept {
+    assert_that(_call, "fn_call_holder: args of moved-from call requested");
+    return *_call->args;
+}
+
 ldb::lv::linda_tuple
 ldb::lv::fn_call_holder::execute(int after_prefix, const linda_tuple& elements) {
     assert_that(gLdb_Dynamic_Function_Map != nullptr,
                 "dynamic execution was not initialized: maybe no functions are dynamically invocable?");
-    auto it = gLdb_Dynamic_Function_Map->find(_fn_name);
+    auto it = gLdb_Dynamic_Function_Map->find(fn_name());
     assert_that(it != gLdb_Dynamic_Function_Map->end(),
                 "dynamic function was not registered in dynamic execution subsystem");
 
-    auto call_result = it->second(*_args);
+    auto call_result = it->second(args());
 
     auto tuple_b = tuple_builder();
     auto tuple_appender = [&tuple_b](auto&& arg) {
@@ -92,7 +116,11 @@ ldb::lv::fn_call_holder::execute(int after_prefix, const linda_tuple& elements)
     return tuple_b.build();
 }
 
-ldb::lv::fn_call_holder::fn_call_holder(ldb::lv::fn_call_holder&& mv) noexcept = default;
+ldb::lv::fn_call_holder::fn_call_holder(ldb::lv::fn_call_holder&& mv) noexcept
+     : _call(std::exchange(mv._call, nullptr)) { }
 
 ldb::lv::fn_call_holder&
-ldb::lv::fn_call_holder::operator=(ldb::lv::fn_call_holder&& mv) noexcept = default;
+ldb::lv::fn_call_holder::operator=(ldb::lv::fn_call_holder&& mv) noexcept {
+    std::swap(_call, mv._call);
+    return *this;
+}
@@ -0,0 +1,83 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/src/lv/linda_array --
+ *   Allocation of the shared buffers of linda_arrays.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#include <ldb/common.hxx>
+#include <ldb/lv/linda_array.hxx>
+
+namespace {
+    // the root header is padded, so the elements following it stay aligned
+    constexpr const std::size_t root_header_size =
+           (sizeof(ldb::lv::helper::array_rep) + ldb::lv::helper::array_alignment - 1)
+           / ldb::lv::helper::array_alignment * ldb::lv::helper::array_alignment;
+}
+
+ldb::lv::helper::array_rep*
+ldb::lv::helper::allocate_array(std::size_t bytes) {
+    auto* raw = static_cast<std::byte*>(::operator new(root_header_size + bytes,
+                                                       std::align_val_t{array_alignment}));
+    return ::new (raw) array_rep{.refs = 1,
+                                 .root = nullptr,
+                                 .data = raw + root_header_size,
+                                 .bytes = bytes};
+}
+
+ldb::lv::helper::array_rep*
+ldb::lv::helper::slice_array(array_rep* rep, std::size_t offset, std::size_t bytes) {
+    assert_that(rep);
+    assert_that(offset + bytes <= rep->bytes);
+    auto* root = rep->root ? rep->root : rep;
+    retain_array(root);
+    return new array_rep{.refs = 1,
+                         .root = root,
+                         .data = rep->data + offset,
+                         .bytes = bytes};
+}
+
+void
+ldb::lv::helper::release_array(array_rep* rep) noexcept {
+    if (rep->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    if (auto* root = rep->root) {
+        delete rep;
+        release_array(root);
+        return;
+    }
+    rep->~array_rep();
+    ::operator delete(rep, std::align_val_t{array_alignment});
+}
@@ -0,0 +1,60 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/src/lv/linda_string --
+ *   Allocation of the shared heap blocks of long linda_strings.
+ */
+
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <string_view>
+
+#include <ldb/lv/linda_string.hxx>
+
+ldb::lv::linda_string::heap_block*
+ldb::lv::linda_string::allocate_block(std::string_view str) {
+    static_assert(alignof(heap_block) >= 2, "the low bit of heap_block pointers is used as a tag");
+    auto* raw = ::operator new(sizeof(heap_block) + str.size() + 1);
+    auto* block = ::new (raw) heap_block{.refs = 1, .size = str.size()};
+    auto* chars = reinterpret_cast<char*>(block + 1);
+    std::memcpy(chars, str.data(), str.size());
+    chars[str.size()] = '\0';
+    return block;
+}
+
+void
+ldb::lv::linda_string::release_block(heap_block* block) noexcept {
+    if (block->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    block->~heap_block();
+    ::operator delete(block);
+}
@@ -0,0 +1,85 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/src/lv/linda_symbol --
+ *   The process-wide intern table of linda_symbols. It is split into shards, each
+ *   with its own lock, so threads interning different texts rarely contend; lookups
+ *   of already interned texts only take a shared lock.
+ */
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include <ldb/lv/linda_symbol.hxx>
+
+namespace {
+    struct intern_shard {
+        std::shared_mutex mtx;
+        // keys view the text of their own entry, which never moves
+        std::unordered_map<std::string_view, std::unique_ptr<ldb::lv::linda_symbol::entry>> entries;
+    };
+
+    constexpr const auto shard_count = std::size_t{16};
+
+    std::array<intern_shard, shard_count>&
+    intern_shards() {
+        static std::array<intern_shard, shard_count> shards;
+        return shards;
+    }
+}
+
+const ldb::lv::linda_symbol::entry*
+ldb::lv::linda_symbol::intern(std::string_view text) {
+    if (text.empty()) return nullptr;
+
+    const auto hash = std::hash<std::string_view>{}(text);
+    auto& shard = intern_shards()[hash % shard_count];
+    {
+        std::shared_lock<std::shared_mutex> lck(shard.mtx);
+        if (const auto it = shard.entries.find(text);
+            it != shard.entries.end()) return it->second.get();
+    }
+
+    std::scoped_lock<std::shared_mutex> lck(shard.mtx);
+    if (const auto it = shard.entries.find(text);
+        it != shard.entries.end()) return it->second.get();
+    auto new_entry = std::make_unique<entry>(entry{.hash = hash, .text = std::string(text)});
+    const auto* result = new_entry.get();
+    shard.entries.emplace(result->text, std::move(new_entry));
+    return result;
+}
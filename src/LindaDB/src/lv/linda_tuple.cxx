@@ -34,31 +34,60 @@
  *   Implements the functions of the linda_tuple type.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <ostream>
-#include <vector>
 
 #include <ldb/lv/linda_tuple.hxx>
 #include <ldb/lv/linda_value.hxx>
 #include <ldb/common.hxx>
 
-ldb::lv::linda_value&
-ldb::lv::linda_tuple::get_at(std::size_t idx) noexcept {
-    assert_that(idx < _size);
-    if (idx < 3) return _data_ref[idx];
-    if (_size == 4 && idx == 3) return std::get<linda_value>(_tail);
-    assert_that(_size > 4);
-    return std::get<std::vector<linda_value>>(_tail)[idx - 3];
+namespace {
+    /// The splitmix64 finalizer: a cheap bijection with good avalanche.
+    constexpr std::uint64_t
+    mix(std::uint64_t x) noexcept {
+        x ^= x >> 30U;
+        x *= 0xbf58'476d'1ce4'e5b9ULL;
+        x ^= x >> 27U;
+        x *= 0x94d0'49bb'1331'11ebULL;
+        x ^= x >> 31U;
+        return x;
+    }
 }
 
-const ldb::lv::linda_value&
-ldb::lv::linda_tuple::get_at(std::size_t idx) const noexcept {
-    assert_that(idx < _size);
-    if (idx < 3) return _data_ref[idx];
-    if (_size == 4 && idx == 3) return std::get<linda_value>(_tail);
-    assert_that(_size > 4);
-    return std::get<std::vector<linda_value>>(_tail)[idx - 3];
+std::uint64_t
+ldb::lv::linda_tuple::hash() const noexcept {
+    if (!_block) return mix(0);
+    if (const auto cached = _block->cached_hash(); cached != 0) return cached;
+
+    // each step feeds the running hash through the mixer, so fields are
+    // position dependent: (a, 1, 2) and (a, 2, 1) do not collide
+    auto result = mix(_size);
+    for (std::size_t i = 0; i < _size; ++i) {
+        const auto field_hash = std::hash<linda_value>{}(_block->values()[i]);
+        result = mix((result ^ field_hash) + 0x9e37'79b9'7f4a'7c15ULL);
+    }
+    if (result == 0) result = 1; // zero marks "not computed"
+    _block->hash.store(result, std::memory_order_relaxed);
+    return result;
+}
+
+std::uint64_t
+ldb::lv::linda_tuple::signature() const noexcept {
+    if (!_block) return tuple_signature::of_arity(0);
+    if (const auto cached = _block->cached_signature(); cached != 0) return cached;
+
+    auto result = tuple_signature::of_arity(_size);
+    const auto tagged = std::min(_size, tuple_signature::tagged_fields);
+    for (std::size_t i = 0; i < tagged; ++i) {
+        result = tuple_signature::with_field(result, i, _block->values()[i].index());
+    }
+    _block->signature.store(result, std::memory_order_relaxed);
+    return result;
 }
 
 std::ostream&
@@ -0,0 +1,201 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * src/LindaDB/tools/clustering_tuner --
+ *   A build-time program that measures the index's clustering factors on the
+ *   build machine and writes the fastest ones into a header consumed by the
+ *   payload_dispatcher.
+ *   Usage: LindaDB-clustering-tuner <output-header> [lookup-percent] [key-count]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <ldb/data/chunked_list.hxx>
+#include <ldb/index/tree/impl/avl2/avl2_tree.hxx>
+#include <ldb/index/tree/index_query.hxx>
+#include <ldb/lv/linda_tuple.hxx>
+#include <ldb/lv/linda_value.hxx>
+
+namespace {
+    namespace lit = ldb::index::tree;
+    using namespace std::literals;
+
+    struct workload {
+        int lookup_percent;
+        std::size_t key_count;
+        std::size_t operations;
+        int rounds;
+    };
+
+    using candidate_clusterings = std::index_sequence<2, 3, 4, 6, 8, 12, 16, 24, 32, 48>;
+
+    /// A measured clustering is only preferred to the heuristic if it is at
+    /// least this much faster, so measurement noise does not override it.
+    constexpr const auto noise_margin = .97;
+
+    std::vector<ldb::lv::linda_value>
+    make_keys(std::size_t count) {
+        std::mt19937_64 rng(42);
+        std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max());
+        std::vector<ldb::lv::linda_value> keys;
+        keys.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto num = dist(rng);
+            if (i % 2 == 0) keys.emplace_back(num);
+            else keys.emplace_back("key-" + std::to_string(num));
+        }
+        return keys;
+    }
+
+    template<class Tree, class K, class V>
+    std::chrono::nanoseconds
+    measure(const workload& load,
+            const std::vector<K>& keys) {
+        auto best = std::chrono::nanoseconds::max();
+        for (int round = 0; round < load.rounds; ++round) {
+            std::mt19937_64 rng(round);
+            std::uniform_int_distribution<std::size_t> pick(0, keys.size() - 1);
+            std::uniform_int_distribution<int> percent(0, 99);
+            std::size_t hits = 0;
+
+            const auto start = std::chrono::steady_clock::now();
+            Tree tree;
+            for (const auto& key : keys) tree.insert(key, V{});
+            for (std::size_t i = 0; i < load.operations; ++i) {
+                const auto& key = keys[pick(rng)];
+                if (percent(rng) < load.lookup_percent) {
+                    if (tree.search(lit::any_value_lookup(key))) ++hits;
+                }
+                else if (tree.remove(lit::any_value_lookup(key))) {
+                    tree.insert(key, V{});
+                }
+            }
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+
+            if (hits > load.operations) std::abort(); // keep lookups observable
+            best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+        }
+        return best;
+    }
+
+    template<class K, class V, std::size_t... Clustering>
+    std::size_t
+    tune(const workload& load,
+         const std::vector<K>& keys,
+         std::index_sequence<Clustering...>) {
+        const auto heuristic = measure<lit::avl2_tree<K, V>, K, V>(load, keys);
+        std::cerr << "  heuristic (" << typename lit::payload_dispatcher<K, V>::type().capacity() << "): "
+                  << heuristic.count() << "ns\n";
+
+        std::size_t best_clustering = 0;
+        auto best = std::chrono::duration_cast<std::chrono::nanoseconds>(heuristic * noise_margin);
+        const auto try_one = [&]<std::size_t C>(std::integral_constant<std::size_t, C>) {
+            const auto time = measure<lit::avl2_tree<K, V, C>, K, V>(load, keys);
+            std::cerr << "  " << C << ": " << time.count() << "ns\n";
+            if (time < best) {
+                best = time;
+                best_clustering = C;
+            }
+        };
+        (try_one(std::integral_constant<std::size_t, Clustering>{}), ...);
+        return best_clustering;
+    }
+
+    void
+    write_specialization(std::ostream& os,
+                         std::string_view key_type,
+                         std::string_view value_type,
+                         std::size_t clustering) {
+        if (clustering == 0) {
+            os << "    // " << key_type << " -> " << value_type << ": heuristic kept\n";
+            return;
+        }
+        os << "    template<>\n"
+           << "    struct tuned_clustering<" << key_type << ",\n"
+           << "                            " << value_type << ">\n"
+           << "         : std::integral_constant<std::size_t, " << clustering << "> { };\n";
+    }
+}
+
+int
+main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <output-header> [lookup-percent] [key-count]\n";
+        return EXIT_FAILURE;
+    }
+
+    workload load{.lookup_percent = argc > 2 ? std::clamp(std::atoi(argv[2]), 0, 100) : 90,
+                  .key_count = argc > 3 ? static_cast<std::size_t>(std::max(std::atoi(argv[3]), 1)) : 20'000,
+                  .operations = 0,
+                  .rounds = 5};
+    load.operations = load.key_count * 4;
+
+    std::cerr << "tuning store index clustering (" << load.lookup_percent << "% lookups, "
+              << load.key_count << " keys)\n";
+    using store_pointer = ldb::data::chunked_list<ldb::lv::linda_tuple>::iterator;
+    const auto store_clustering = tune<ldb::lv::linda_value, store_pointer>(load,
+                                                                            make_keys(load.key_count),
+                                                                            candidate_clusterings{});
+
+    std::ofstream out(argv[1]);
+    out << "// Generated by LindaDB-clustering-tuner. Do not edit.\n"
+           "#ifndef LINDADB_TUNED_CLUSTERING_HXX\n"
+           "#define LINDADB_TUNED_CLUSTERING_HXX\n"
+           "\n"
+           "#include <cstddef>\n"
+           "#include <type_traits>\n"
+           "\n"
+           "#include <ldb/data/chunked_list.hxx>\n"
+           "#include <ldb/lv/linda_tuple.hxx>\n"
+           "#include <ldb/lv/linda_value.hxx>\n"
+           "\n"
+           "namespace ldb::index::tree {\n";
+    write_specialization(out,
+                         "lv::linda_value"sv,
+                         "data::chunked_list<lv::linda_tuple>::iterator"sv,
+                         store_clustering);
+    out << "}\n"
+           "\n"
+           "#endif\n";
+    return out ? EXIT_SUCCESS : EXIT_FAILURE;
+}
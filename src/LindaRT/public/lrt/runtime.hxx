@@ -36,14 +36,107 @@
 #ifndef LINDADB_RUNTIME_HXX
 #define LINDADB_RUNTIME_HXX
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include <ldb/lv/linda_tuple.hxx>
+#include <ldb/lv/linda_value.hxx>
+#include <ldb/query/manual_fields_query.hxx>
+#include <ldb/query/match_type.hxx>
+#include <ldb/query/meta_finder.hxx>
 #include <ldb/store.hxx>
 
 namespace lrt {
+    /// How the tuples of the space are spread over the ranks.
+    enum class distribution {
+        /// Every rank holds every tuple: insertions and deletions are sent to all ranks.
+        replicated,
+        /// Each tuple lives only on its owner, the rank its first field hashes to.
+        partitioned,
+        /// Every node holds every tuple once: the ranks sharing a node use the
+        /// replica of the first of them, their node leader, and only the
+        /// leaders send insertions and deletions to each other.
+        node_shared,
+    };
+
+    /**
+     * How a rank receives: the receives it keeps posted ahead of the
+     * messages, and the workers applying the received operations to the
+     * store. Senders rely on the size of the buffers, so every rank has to
+     * use the same.
+     */
+    struct receive_options {
+        /// Messages up to this many bytes are received into a posted buffer;
+        /// larger ones are announced and received separately.
+        std::size_t buffer_size = 32 * 1024;
+        /// The number of receives posted at once.
+        std::size_t buffer_count = 16;
+        /// The threads decoding and applying received operations. Each origin
+        /// is served by one of them, in order. With none, the receiving
+        /// thread applies them itself. Node leaders and funneled runtimes
+        /// always have at least one: there the receiving thread also sends
+        /// the broadcasts which other threads hold store locks for.
+        std::size_t apply_workers = 2;
+        /// Replicate through one-sided communication: every rank writes its
+        /// broadcasts straight into a ring per sender in the memory of the
+        /// receiver, which drains them without matching messages.
+        bool one_sided = false;
+        /// The bytes of each of those rings.
+        std::size_t ring_size = 64 * 1024;
+        /// Print every received insert and remove to stdout as it is applied.
+        /// Only for debugging: it serializes the appliers on the stream.
+        bool trace = false;
+    };
+
+    /// Which threads of the runtime call into MPI.
+    enum class mpi_threading {
+        /// Any thread sends on its own; requires MPI_THREAD_MULTIPLE (or at least SERIALIZED).
+        multiple,
+        /// A single communication thread makes every MPI call, taking the sends
+        /// of the other threads from a queue; requires only MPI_THREAD_FUNNELED.
+        funneled,
+    };
+
+    // the MPI communicators of the runtime, defined where MPI is available
+    struct message_channel;
+    // a send or a barrier in progress on the channel
+    struct posted_operation;
+
+    namespace meta {
+        template<class T>
+        struct is_match_type : std::false_type { };
+
+        template<class T>
+        struct is_match_type<ldb::match_type<T>> : std::true_type {
+            using stored_type = ldb::meta::stored_alternative_t<T>;
+        };
+
+        template<class T>
+        concept template_field = ldb::lv::is_linda_value_v<std::remove_cvref_t<T>>
+                                 || is_match_type<std::remove_cvref_t<T>>::value;
+    }
+
     struct runtime {
-        runtime(int* argc, char*** argv);
+        runtime(int* argc,
+                char*** argv,
+                distribution mode = distribution::replicated,
+                receive_options options = {},
+                mpi_threading threading = mpi_threading::multiple);
 
         runtime(const runtime& cp) = delete;
         runtime(runtime&& mv) noexcept = delete;
@@ -54,22 +147,244 @@ namespace lrt {
 
         ~runtime() noexcept;
 
+        /// The local part of the space. In a partitioned runtime it only
+        /// holds the tuples this rank owns, and in a node-shared one it is
+        /// empty but on node leaders: use the operations of the runtime.
         ldb::store&
         store() noexcept { return _store; }
 
         const ldb::store&
         store() const noexcept { return _store; }
 
+        [[nodiscard]] distribution
+        mode() const noexcept { return _mode; }
+
+        [[nodiscard]] int
+        rank() const noexcept { return _rank; }
+
+        [[nodiscard]] int
+        size() const noexcept { return _size; }
+
+        /// Waits for every rank to get here. With funneled MPI, other threads
+        /// must not call MPI themselves: this is the barrier to use.
+        void
+        barrier();
+
+        /// Places tuple in the space: on every rank, or on its owner if partitioned.
+        void
+        out(const ldb::lv::linda_tuple& tuple);
+
+        template<meta::template_field... Args>
+        std::optional<ldb::lv::linda_tuple>
+        rdp(Args&&... args) {
+            return retrieve(request_kind::rdp, std::forward<Args>(args)...);
+        }
+
+        template<meta::template_field... Args>
+        ldb::lv::linda_tuple
+        rd(Args&&... args) {
+            return *retrieve(request_kind::rd, std::forward<Args>(args)...);
+        }
+
+        template<meta::template_field... Args>
+        std::optional<ldb::lv::linda_tuple>
+        inp(Args&&... args) {
+            return retrieve(request_kind::inp, std::forward<Args>(args)...);
+        }
+
+        template<meta::template_field... Args>
+        ldb::lv::linda_tuple
+        in(Args&&... args) {
+            return *retrieve(request_kind::in, std::forward<Args>(args)...);
+        }
+
     private:
+        enum class request_kind : std::uint8_t {
+            rdp,
+            inp,
+            rd,
+            in,
+        };
+
+        using index_type = ldb::index::tree::avl2_tree<ldb::lv::linda_value,
+                                                       ldb::store::pointer_type>;
+
         inline static std::atomic_flag _mpi_inited = ATOMIC_FLAG_INIT;
 
+        [[nodiscard]] constexpr static request_kind
+        nonblocking(request_kind kind) noexcept {
+            switch (kind) {
+            case request_kind::rd: return request_kind::rdp;
+            case request_kind::in: return request_kind::inp;
+            default: return kind;
+            }
+        }
+
+        template<class... Args>
+        std::optional<ldb::lv::linda_tuple>
+        retrieve(request_kind kind, Args&&... args) {
+            if (_mode == distribution::replicated || holds_replica()) return retrieve_local(kind, std::forward<Args>(args)...);
+
+            const auto formals = formal_mask<std::remove_cvref_t<Args>...>();
+            const ldb::lv::linda_tuple values(wire_value(args)...);
+            if (_mode == distribution::node_shared) {
+                auto found = retrieve_remote(_leader, kind, values, formals);
+                if (found) bind_formals(*found, args...);
+                return found;
+            }
+            if (values.size() > 0 && (formals & 1U) == 0U) {
+                const auto owner = owner_of(values[0]);
+                if (owner == _rank) return retrieve_local(kind, std::forward<Args>(args)...);
+                auto found = retrieve_remote(owner, kind, values, formals);
+                if (found) bind_formals(*found, args...);
+                return found;
+            }
+
+            // the owner of a formal header is unknown: ask every rank in turn, starting here
+            constexpr const auto max_backoff = std::chrono::milliseconds(10);
+            for (std::chrono::microseconds backoff(50);; backoff = std::min<std::chrono::microseconds>(2 * backoff, max_backoff)) {
+                for (int i = 0; i < _size; ++i) {
+                    const auto rank = (_rank + i) % _size;
+                    auto found = rank == _rank
+                                        ? retrieve_local(nonblocking(kind), args...)
+                                        : retrieve_remote(rank, nonblocking(kind), values, formals);
+                    if (!found) continue;
+                    if (rank != _rank) bind_formals(*found, args...);
+                    return found;
+                }
+                if (kind == nonblocking(kind)) return std::nullopt;
+                std::this_thread::sleep_for(backoff);
+            }
+        }
+
+        template<class... Args>
+        std::optional<ldb::lv::linda_tuple>
+        retrieve_local(request_kind kind, Args&&... args) {
+            switch (kind) {
+            case request_kind::rdp: return _store.rdp(std::forward<Args>(args)...);
+            case request_kind::inp: return _store.inp(std::forward<Args>(args)...);
+            case request_kind::rd: return _store.rd(std::forward<Args>(args)...);
+            case request_kind::in: return _store.in(std::forward<Args>(args)...);
+            }
+            return std::nullopt;
+        }
+
+        template<class... Args>
+        [[nodiscard]] constexpr static std::uint64_t
+        formal_mask() noexcept {
+            static_assert(sizeof...(Args) <= 64, "templates have at most 64 fields");
+            return []<std::size_t... Is>(std::index_sequence<Is...>) {
+                return ((meta::is_match_type<Args>::value ? std::uint64_t{1} << Is : std::uint64_t{0}) | ... | std::uint64_t{0});
+            }(std::index_sequence_for<Args...>());
+        }
+
+        /// A template field as sent to the owner: formals become a value of their type.
+        template<class Arg>
+        [[nodiscard]] static ldb::lv::linda_value
+        wire_value(const Arg& arg) {
+            if constexpr (meta::is_match_type<Arg>::value) {
+                return typename meta::is_match_type<Arg>::stored_type{};
+            }
+            else {
+                return ldb::lv::make_linda_value(arg);
+            }
+        }
+
+        template<class... Args>
+        static void
+        bind_formals(const ldb::lv::linda_tuple& found, const Args&... args) {
+            std::ignore = ldb::make_query(ldb::over_index<index_type>, args...).matches(found);
+        }
+
+        [[nodiscard]] int
+        owner_of(const ldb::lv::linda_value& header) const noexcept;
+
+        /// Whether this rank holds a replica of the whole space, kept up to date by broadcasts.
+        [[nodiscard]] bool
+        holds_replica() const noexcept {
+            return _mode == distribution::replicated
+                   || (_mode == distribution::node_shared && _leader == _rank);
+        }
+
+        /// The ranks this one sends a broadcast of root on to.
+        [[nodiscard]] std::vector<int>
+        broadcast_children(int root) const;
+
+        std::optional<ldb::lv::linda_tuple>
+        retrieve_remote(int rank,
+                        request_kind kind,
+                        const ldb::lv::linda_tuple& values,
+                        std::uint64_t formals);
+
         void
-        recv_thread_worker();
+        serve_request(int rank,
+                      std::uint64_t id,
+                      request_kind kind,
+                      const ldb::lv::linda_tuple& values,
+                      std::uint64_t formals);
 
-        int _rank;
-        std::atomic_flag _recv_start = ATOMIC_FLAG_INIT;
-        std::thread _recv_thr;
+        /// Replies to the waiting requests a tuple added since matches.
+        void
+        serve_waiting();
+
+        void
+        reply_request(int rank, std::uint64_t id, const std::optional<ldb::lv::linda_tuple>& found);
+
+        void
+        post_sends(std::vector<int> ranks, int tag, std::vector<std::byte>&& message);
+
+        /// Keeps posted until it completed.
+        void
+        track(std::shared_ptr<posted_operation> posted);
+
+        void
+        relay_broadcast(int root, int tag, std::span<const std::byte> message);
+
+        void
+        apply_frame(std::span<std::byte> frame);
+
+        /// Applies an operation received from source to the store.
+        void
+        apply_received(int source, int tag, std::span<std::byte> payload);
+
+        void
+        init_mpi(int* argc, char*** argv);
+
+        void
+        recv_thread_worker(int* argc, char*** argv);
+
+        distribution _mode;
+        receive_options _options;
+        mpi_threading _threading;
+        int _rank{};
+        int _size{};
+        // the rank holding the replica this one uses, when node-shared
+        int _leader{};
+        // the ranks holding replicas, which broadcasts are relayed between
+        std::vector<int> _replicas{};
+        std::unique_ptr<message_channel> _channel;
+        // set by the communication thread once it initialized MPI, when funneled
+        std::atomic_flag _mpi_ready = ATOMIC_FLAG_INIT;
+        std::exception_ptr _init_error{};
+        std::thread _recv_thr{};
         ldb::store _store{};
+
+        std::atomic<std::uint64_t> _next_request_id{0};
+        std::mutex _pending_mtx;
+        std::unordered_map<std::uint64_t, std::promise<std::optional<ldb::lv::linda_tuple>>> _pending{};
+
+        // a blocking request of another rank, waiting for a matching tuple
+        struct waiting_request {
+            int rank;
+            std::uint64_t id;
+            bool removes;
+            ldb::store::query_type query;
+        };
+        std::mutex _waiting_mtx;
+        std::vector<waiting_request> _waiting{};
+        std::mutex _sends_mtx;
+        // replies and relayed broadcasts still being sent from the receiving thread
+        std::vector<std::shared_ptr<posted_operation>> _sends{};
     };
 }
 
@@ -36,12 +36,21 @@
 #ifndef LINDADB_TUPLE_HXX
 #define LINDADB_TUPLE_HXX
 
+#include <cstddef>
 #include <memory>
+#include <span>
+#include <utility>
+#include <vector>
 
 #include <ldb/lv/linda_tuple.hxx>
 #include <ldb/lv/linda_value.hxx>
 
 namespace lrt {
+    /// Appends the serialized tuple to buf, returning the number of bytes
+    /// appended. Reusing buf keeps serialization free of allocations.
+    std::size_t
+    serialize_into(std::vector<std::byte>& buf, const ldb::lv::linda_tuple& tuple);
+
     std::pair<std::unique_ptr<std::byte[]>, std::size_t>
     serialize(const ldb::lv::linda_tuple& tuple);
 
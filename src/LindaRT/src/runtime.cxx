@@ -35,206 +35,1239 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
-#include <execution>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
 #include <ios>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
 #include <span>
 #include <stdexcept>
+#include <string>
 #include <syncstream>
+#include <thread>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include <ldb/bcast/broadcaster.hxx>
+#include <ldb/data/mpsc_queue.hxx>
+#include <ldb/data/spsc_queue.hxx>
 #include <ldb/lv/linda_tuple.hxx>
+#include <ldb/query/template_tuple_query.hxx>
 #include <lrt/runtime.hxx>
 #include <lrt/serialize/tuple.hxx>
 
 #include <mpi.h>
 
+struct lrt::posted_operation {
+    enum class kind : std::uint8_t {
+        send,
+        barrier,
+        ring_write,
+    };
+
+    kind what;
+    // the message and its recipients, kept until the sends completed
+    std::vector<std::byte> buffer{};
+    std::vector<int> ranks{};
+    int tag{};
+    std::vector<MPI_Request> requests{};
+    // the recipients whose ring does not hold the whole message yet, for ring writes
+    std::size_t unwritten_targets{};
+    // set by the communication thread once completed, when funneled
+    std::atomic_flag done = ATOMIC_FLAG_INIT;
+};
+
 namespace {
-    constexpr const int LINDA_RT_TERMINATE_TAG = 0xDB'00'01;
-    constexpr const int LINDA_RT_DB_SYNC_INSERT_TAG = 0xDB'00'02;
-    constexpr const int LINDA_RT_DB_SYNC_DELETE_TAG = 0xDB'00'03;
+    template<class T>
+    void
+    write_raw(std::byte*& out, T value) {
+        std::memcpy(out, &value, sizeof(T));
+        out += sizeof(T);
+    }
+
+    template<class T>
+    T
+    read_raw(std::span<std::byte>& in) {
+        T value;
+        std::memcpy(&value, in.data(), sizeof(T));
+        in = in.subspan(sizeof(T));
+        return value;
+    }
 
-    struct mpi_request_vector_awaiter final {
-        mpi_request_vector_awaiter(std::vector<MPI_Request>&& reqs,
-                                   std::unique_ptr<std::byte[]>&& buf)
-             : _reqs(std::move(reqs)),
-               _buf(std::move(buf)) { }
+    /**
+     * Replication over one-sided communication. Every rank exposes a window
+     * with a ring for each other rank, written only by that rank, and two
+     * counters per peer:
+     *
+     *   [u64 tail of each peer][u64 consumed by each peer][ring of each peer]
+     *
+     * A writer puts its bytes into its ring at the target and, once they
+     * landed, atomically replaces its tail there with the count of bytes it
+     * wrote. The reader drains its rings up to their tails in one go, then
+     * hands each writer its consumed count the same way, which frees the
+     * space for the writer. The rings carry streams of records
+     *   [u32 tag][u32 length][payload]
+     * and a record larger than the free space is written in pieces.
+     */
+    struct rma_rings final {
+        constexpr const static std::size_t record_header_size = 2 * sizeof(std::uint32_t);
+
+        rma_rings(MPI_Comm comm, std::size_t ring_size)
+             : _ring_size(ring_size) {
+            MPI_Comm_rank(comm, &_rank);
+            MPI_Comm_size(comm, &_size);
+            const auto peers = static_cast<std::size_t>(_size);
+            MPI_Win_allocate(static_cast<MPI_Aint>(2 * peers * sizeof(std::uint64_t) + peers * ring_size),
+                             1,
+                             MPI_INFO_NULL,
+                             comm,
+                             &_base,
+                             &_win);
+            std::memset(_base, 0, 2 * peers * sizeof(std::uint64_t));
+            // nobody may write before the counters are cleared everywhere
+            MPI_Barrier(comm);
+            MPI_Win_lock_all(MPI_MODE_NOCHECK, _win);
+            _streams.resize(peers);
+            _readers.resize(peers);
+        }
+
+        rma_rings(const rma_rings& cp) = delete;
+        rma_rings&
+        operator=(const rma_rings& cp) = delete;
+
+        /// Collective, like the creation.
+        ~rma_rings() noexcept {
+            MPI_Win_unlock_all(_win);
+            MPI_Win_free(&_win);
+        }
+
+        void
+        enqueue(const std::shared_ptr<lrt::posted_operation>& operation) {
+            std::scoped_lock<std::mutex> lck(_write_mtx);
+            operation->unwritten_targets = operation->ranks.size();
+            for (const auto rank : operation->ranks) {
+                pending_write write{operation, 0, {}};
+                auto* out = write.header.data();
+                write_raw(out, static_cast<std::uint32_t>(operation->tag));
+                write_raw(out, static_cast<std::uint32_t>(operation->buffer.size()));
+                _streams[static_cast<std::size_t>(rank)].pending.push_back(std::move(write));
+            }
+            write_pending();
+        }
+
+        /// Writes what fits; returns whether operation is in every ring it goes to.
+        [[nodiscard]] bool
+        written(const lrt::posted_operation& operation) {
+            std::scoped_lock<std::mutex> lck(_write_mtx);
+            write_pending();
+            return operation.unwritten_targets == 0;
+        }
+
+        void
+        progress() {
+            std::scoped_lock<std::mutex> lck(_write_mtx);
+            write_pending();
+        }
+
+        /// Receiving thread only: hands every record written to this rank to
+        /// handle(source, tag, payload). Returns whether there were any.
+        bool
+        poll(const std::invocable<int, int, std::span<std::byte>> auto& handle) {
+            const auto tails = read_counters(tail_disp(0));
+            MPI_Win_sync(_win);
+
+            auto drained = false;
+            for (int source = 0; source < _size; ++source) {
+                auto& in = _readers[static_cast<std::size_t>(source)];
+                const auto tail = tails[static_cast<std::size_t>(source)];
+                if (in.consumed == tail) continue;
+                drained = true;
+
+                const auto ring = ring_of(source);
+                while (in.consumed < tail) {
+                    const auto available = tail - in.consumed;
+                    const auto at = static_cast<std::size_t>(in.consumed % _ring_size);
+
+                    // a record in one piece is handled where it landed
+                    if (in.partial.empty() && available >= record_header_size && at + record_header_size <= _ring_size) {
+                        auto header = ring.subspan(at, record_header_size);
+                        const auto tag = read_raw<std::uint32_t>(header);
+                        const auto length = read_raw<std::uint32_t>(header);
+                        const auto record_size = record_header_size + length;
+                        if (available >= record_size && at + record_size <= _ring_size) {
+                            handle(source, static_cast<int>(tag), ring.subspan(at + record_header_size, length));
+                            in.consumed += record_size;
+                            continue;
+                        }
+                    }
+
+                    // otherwise it is gathered as it arrives
+                    const auto wanted = in.partial.size() < record_header_size
+                                              ? record_header_size - in.partial.size()
+                                              : record_header_size + partial_length(in) - in.partial.size();
+                    const auto n = std::min({static_cast<std::size_t>(available), wanted, _ring_size - at});
+                    in.partial.insert(in.partial.end(), ring.begin() + static_cast<std::ptrdiff_t>(at), ring.begin() + static_cast<std::ptrdiff_t>(at + n));
+                    in.consumed += n;
+                    if (in.partial.size() >= record_header_size
+                        && in.partial.size() == record_header_size + partial_length(in)) {
+                        auto record = std::span(in.partial);
+                        const auto tag = read_raw<std::uint32_t>(record);
+                        handle(source, static_cast<int>(tag), record.subspan(sizeof(std::uint32_t)));
+                        in.partial.clear();
+                    }
+                }
+                MPI_Accumulate(&in.consumed, 1, MPI_UINT64_T, source, consumed_disp(_rank), 1, MPI_UINT64_T, MPI_REPLACE, _win);
+            }
+            if (drained) MPI_Win_flush_all(_win);
+            return drained;
+        }
 
     private:
-        friend void
-        await(mpi_request_vector_awaiter& awaiter) {
-            assert_that(!awaiter._finished);
-            MPI_Waitall(static_cast<int>(awaiter._reqs.size()),
-                        awaiter._reqs.data(),
-                        MPI_STATUS_IGNORE);
-            awaiter._finished = true;
-            awaiter._buf.reset();
-        }
-
-        bool _finished{};
-        std::vector<MPI_Request> _reqs;
-        std::unique_ptr<std::byte[]> _buf;
+        struct pending_write {
+            std::shared_ptr<lrt::posted_operation> operation;
+            // how much of the record is written
+            std::size_t offset;
+            std::array<std::byte, record_header_size> header;
+        };
+
+        struct stream {
+            std::uint64_t written{};
+            std::deque<pending_write> pending{};
+        };
+
+        struct reader {
+            std::uint64_t consumed{};
+            // a record arriving in pieces
+            std::vector<std::byte> partial{};
+        };
+
+        [[nodiscard]] MPI_Aint
+        tail_disp(int rank) const noexcept {
+            return static_cast<MPI_Aint>(static_cast<std::size_t>(rank) * sizeof(std::uint64_t));
+        }
+
+        [[nodiscard]] MPI_Aint
+        consumed_disp(int rank) const noexcept {
+            return static_cast<MPI_Aint>(static_cast<std::size_t>(_size + rank) * sizeof(std::uint64_t));
+        }
+
+        [[nodiscard]] MPI_Aint
+        ring_disp(int rank) const noexcept {
+            return static_cast<MPI_Aint>(2 * static_cast<std::size_t>(_size) * sizeof(std::uint64_t)
+                                         + static_cast<std::size_t>(rank) * _ring_size);
+        }
+
+        [[nodiscard]] std::span<std::byte>
+        ring_of(int rank) const noexcept {
+            return {_base + ring_disp(rank), _ring_size};
+        }
+
+        [[nodiscard]] static std::size_t
+        partial_length(const reader& in) noexcept {
+            std::uint32_t length;
+            std::memcpy(&length, in.partial.data() + sizeof(std::uint32_t), sizeof(length));
+            return length;
+        }
+
+        /// The counters of every peer starting at disp in the window of this rank.
+        std::vector<std::uint64_t>
+        read_counters(MPI_Aint disp) {
+            std::vector<std::uint64_t> values(static_cast<std::size_t>(_size));
+            MPI_Get_accumulate(nullptr, 0, MPI_UINT64_T,
+                               values.data(), _size, MPI_UINT64_T,
+                               _rank, disp, _size, MPI_UINT64_T,
+                               MPI_NO_OP, _win);
+            MPI_Win_flush(_rank, _win);
+            return values;
+        }
+
+        void
+        put(int target, std::uint64_t position, std::span<const std::byte> bytes) {
+            while (!bytes.empty()) {
+                const auto at = static_cast<std::size_t>(position % _ring_size);
+                const auto n = std::min(bytes.size(), _ring_size - at);
+                MPI_Put(bytes.data(), static_cast<int>(n), MPI_CHAR,
+                        target, ring_disp(_rank) + static_cast<MPI_Aint>(at), static_cast<int>(n), MPI_CHAR,
+                        _win);
+                bytes = bytes.subspan(n);
+                position += n;
+            }
+        }
+
+        void
+        write_pending() {
+            if (std::ranges::all_of(_streams, [](const stream& out) { return out.pending.empty(); })) return;
+
+            const auto consumed = read_counters(consumed_disp(0));
+            // the writes have to outlive their puts
+            std::vector<pending_write> completed;
+            auto wrote = false;
+            for (int target = 0; target < _size; ++target) {
+                auto& out = _streams[static_cast<std::size_t>(target)];
+                auto free = _ring_size - static_cast<std::size_t>(out.written - consumed[static_cast<std::size_t>(target)]);
+                const auto before = out.written;
+                while (!out.pending.empty() && free > 0) {
+                    auto& write = out.pending.front();
+                    const auto& payload = write.operation->buffer;
+                    const auto n = std::min(free, record_header_size + payload.size() - write.offset);
+
+                    // the record is its header then its payload, and n bytes of it fit
+                    const auto from_header = write.offset < record_header_size
+                                                   ? std::min(n, record_header_size - write.offset)
+                                                   : 0;
+                    if (from_header > 0) {
+                        put(target, out.written, std::span<const std::byte>(write.header).subspan(write.offset, from_header));
+                    }
+                    if (n > from_header) {
+                        const auto payload_offset = write.offset > record_header_size ? write.offset - record_header_size : 0;
+                        put(target, out.written + from_header, std::span(payload).subspan(payload_offset, n - from_header));
+                    }
+
+                    write.offset += n;
+                    out.written += n;
+                    free -= n;
+                    if (write.offset == record_header_size + payload.size()) {
+                        completed.push_back(std::move(write));
+                        out.pending.pop_front();
+                    }
+                }
+                if (out.written == before) continue;
+
+                // the tail only moves once the bytes before it are there
+                MPI_Win_flush(target, _win);
+                MPI_Accumulate(&out.written, 1, MPI_UINT64_T, target, tail_disp(_rank), 1, MPI_UINT64_T, MPI_REPLACE, _win);
+                wrote = true;
+            }
+            if (!wrote) return;
+
+            MPI_Win_flush_all(_win);
+            for (auto& write : completed) --write.operation->unwritten_targets;
+        }
+
+        std::size_t _ring_size;
+        int _rank{};
+        int _size{};
+        std::byte* _base{};
+        MPI_Win _win{MPI_WIN_NULL};
+
+        std::mutex _write_mtx;
+        std::vector<stream> _streams;
+        std::vector<reader> _readers;
     };
+}
 
-    static_assert(ldb::awaitable<mpi_request_vector_awaiter>);
+/*
+ * The point-to-point messages of the runtime. Receivers keep buffers of
+ * eager_limit bytes posted, so larger messages travel on a communicator of
+ * their own. They are announced on the main one by an empty message, with
+ * large_message_flag set in its tag, which keeps the order of the messages
+ * between two ranks.
+ *
+ * When funneled, operations are not started by the thread asking for them
+ * but pushed onto the funnel: the communication thread starts them and tests
+ * them for completion in progress(), between polling for received messages.
+ */
+struct lrt::message_channel {
+    constexpr const static int large_message_flag = 0x1000'0000;
 
-    MPI_Request
-    start_send_buffer_to_with_tag(const std::span<std::byte> buffer,
-                                  int to_rank,
-                                  int tag) {
+    message_channel(MPI_Comm comm, std::size_t eager_limit, bool funneled)
+         : comm(comm),
+           eager_limit(eager_limit),
+           funneled(funneled) { }
+
+    MPI_Comm comm;
+    MPI_Comm bulk_comm{MPI_COMM_NULL};
+    std::size_t eager_limit;
+    bool funneled;
+    // carry the replication, when one-sided
+    std::unique_ptr<rma_rings> rings{};
+
+    /// Starts sending message to each of ranks.
+    std::shared_ptr<posted_operation>
+    start(std::vector<std::byte> message, std::vector<int> ranks, int tag) {
+        return post(std::make_shared<posted_operation>(posted_operation::kind::send,
+                                                       std::move(message),
+                                                       std::move(ranks),
+                                                       tag));
+    }
+
+    /// Starts sending a broadcast frame or flush to each of ranks: through
+    /// their rings, when one-sided.
+    std::shared_ptr<posted_operation>
+    start_replication(std::vector<std::byte> message, std::vector<int> ranks, int tag) {
+        return post(std::make_shared<posted_operation>(rings ? posted_operation::kind::ring_write
+                                                             : posted_operation::kind::send,
+                                                       std::move(message),
+                                                       std::move(ranks),
+                                                       tag));
+    }
+
+    std::shared_ptr<posted_operation>
+    start_barrier() {
+        return post(std::make_shared<posted_operation>(posted_operation::kind::barrier));
+    }
+
+    /// Returns once operation completed.
+    void
+    wait(posted_operation& operation) const {
+        if (funneled) {
+            operation.done.wait(false);
+            return;
+        }
+        if (operation.what == posted_operation::kind::ring_write) {
+            while (!rings->written(operation)) std::this_thread::yield();
+            return;
+        }
+        MPI_Waitall(static_cast<int>(operation.requests.size()), operation.requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    [[nodiscard]] bool
+    test(posted_operation& operation) const {
+        if (funneled) return operation.done.test();
+        return test_now(operation);
+    }
+
+    void
+    send(std::vector<std::byte> message, int rank, int tag) {
+        wait(*start(std::move(message), {rank}, tag));
+    }
+
+    /// Communication thread: starts the queued operations and completes the
+    /// ones in flight. Returns whether any of them made progress.
+    bool
+    progress(std::vector<std::shared_ptr<posted_operation>>& in_flight) {
+        if (rings) rings->progress();
+        auto progressed = false;
+        while (auto operation = _funnel.try_pop()) {
+            start_now(*operation);
+            in_flight.push_back(*std::move(operation));
+            progressed = true;
+        }
+        std::erase_if(in_flight, [this, &progressed](const std::shared_ptr<posted_operation>& operation) {
+            if (!test_now(*operation)) return false;
+            operation->done.test_and_set();
+            operation->done.notify_all();
+            progressed = true;
+            return true;
+        });
+        return progressed;
+    }
+
+private:
+    std::shared_ptr<posted_operation>
+    post(std::shared_ptr<posted_operation> operation) {
+        if (funneled) _funnel.push(operation);
+        else start_now(operation);
+        return operation;
+    }
+
+    void
+    start_now(const std::shared_ptr<posted_operation>& posted) const {
+        auto& operation = *posted;
+        if (operation.what == posted_operation::kind::barrier) {
+            MPI_Ibarrier(comm, &operation.requests.emplace_back(MPI_REQUEST_NULL));
+            return;
+        }
+        if (operation.what == posted_operation::kind::ring_write) {
+            rings->enqueue(posted);
+            return;
+        }
+
+        for (const auto rank : operation.ranks) {
+            if (operation.buffer.size() <= eager_limit) {
+                operation.requests.push_back(start_send(operation.buffer, rank, operation.tag, comm));
+                continue;
+            }
+            operation.requests.push_back(start_send({}, rank, operation.tag | large_message_flag, comm));
+            operation.requests.push_back(start_send(operation.buffer, rank, operation.tag, bulk_comm));
+        }
+    }
+
+    [[nodiscard]] bool
+    test_now(posted_operation& operation) const {
+        if (operation.what == posted_operation::kind::ring_write) return rings->written(operation);
+        int done{};
+        MPI_Testall(static_cast<int>(operation.requests.size()), operation.requests.data(), &done, MPI_STATUSES_IGNORE);
+        return done != 0;
+    }
+
+    static MPI_Request
+    start_send(std::span<const std::byte> buffer,
+               int to_rank,
+               int tag,
+               MPI_Comm on_comm) {
         auto req = MPI_REQUEST_NULL;
         if (const auto status = MPI_Isend(buffer.data(),
                                           static_cast<int>(buffer.size()),
                                           MPI_CHAR,
                                           to_rank,
                                           tag,
-                                          MPI_COMM_WORLD,
+                                          on_comm,
                                           &req);
             status != 0) return MPI_REQUEST_NULL;
         return req;
     }
 
-    struct manual_broadcast_handler final {
-        using await_type = mpi_request_vector_awaiter;
+    ldb::data::mpsc_queue<std::shared_ptr<posted_operation>> _funnel;
+};
+
+namespace {
+    constexpr const int LINDA_RT_TERMINATE_TAG = 0xDB'00'01;
+    constexpr const int LINDA_RT_DB_SYNC_FRAME_TAG = 0xDB'00'02;
+    constexpr const int LINDA_RT_REQUEST_TAG = 0xDB'00'04;
+    constexpr const int LINDA_RT_REPLY_TAG = 0xDB'00'05;
+    constexpr const int LINDA_RT_OWNER_INSERT_TAG = 0xDB'00'06;
+    constexpr const int LINDA_RT_FLUSH_TAG = 0xDB'00'07;
+
+    /*
+     * Requests of a partitioned runtime carry a template to its owner:
+     *   [u64 request id][u64 formal mask][u8 kind][serialized tuple]
+     * and the owner answers with
+     *   [u64 request id][u8 found][serialized tuple, if found]
+     */
+    constexpr const std::size_t REQUEST_HEADER_SIZE = 2 * sizeof(std::uint64_t) + 1;
+    constexpr const std::size_t REPLY_HEADER_SIZE = sizeof(std::uint64_t) + 1;
+
+    /*
+     * Broadcasts are relayed over a binomial tree rooted at their origin, so
+     * they start with the rank of the root:
+     *   [i32 root][serialized tuple]
+     */
+    constexpr const std::size_t BROADCAST_HEADER_SIZE = sizeof(std::int32_t);
+
+    /*
+     * The insertions and deletions of a rank are coalesced into frames: a
+     * broadcast header followed by the operations in order. Tuples are named
+     * by their ids, so only insertions carry the tuple:
+     *   insert: [u8 operation][u32 origin][u64 sequence][u32 length][serialized tuple]
+     *   remove: [u8 operation][u32 origin][u64 sequence]
+     */
+    enum class frame_op : std::uint8_t {
+        insert,
+        remove,
+    };
+    constexpr const std::size_t FRAME_OP_HEADER_SIZE = 1 + ldb::data::tuple_id_wire_size;
+
+    // frames received but not yet applied, per applying worker, before the receiving thread waits
+    constexpr const std::size_t APPLY_LANE_CAPACITY = 1024;
+
+    // a message handed from the receiving thread to an applying worker
+    struct received_operation {
+        int source;
+        int tag;
+        // an empty payload closes the lane
+        std::vector<std::byte> payload;
+    };
+
+    std::vector<std::byte>
+    encode_with_header(std::size_t header_size,
+                       const ldb::lv::linda_tuple* tuple,
+                       const std::invocable<std::byte*&> auto& write_header) {
+        std::vector<std::byte> buf(header_size);
+        auto* out = buf.data();
+        write_header(out);
+        if (tuple) lrt::serialize_into(buf, *tuple);
+        return buf;
+    }
+
+    /**
+     * The ranks rank relays a broadcast of root to. Relative to the root, a
+     * rank receives from the rank without its lowest set bit, and sends on
+     * to itself plus each lower power of two, so every rank sends at most
+     * log2(size) messages and each message reaches everyone in log2(size)
+     * steps. The larger subtrees come first.
+     */
+    std::vector<int>
+    binomial_children(int rank, int root, int size) {
+        const auto relative = (rank - root + size) % size;
+        auto mask = 1;
+        while (mask < size && (relative & mask) == 0) mask <<= 1;
+
+        std::vector<int> children;
+        for (mask >>= 1; mask > 0; mask >>= 1) {
+            if (relative + mask < size) children.push_back((relative + mask + root) % size);
+        }
+        return children;
+    }
+
+    std::vector<std::byte>
+    encode_broadcast(int root, const ldb::lv::linda_tuple* tuple) {
+        return encode_with_header(BROADCAST_HEADER_SIZE, tuple, [root](std::byte*& out) {
+            write_raw(out, static_cast<std::int32_t>(root));
+        });
+    }
+
+    /**
+     * The receives of the receiving thread, posted ahead of the messages into
+     * a ring of buffers, so a message costs one call into MPI and no
+     * allocation. Receives posted earlier match earlier messages, so waiting
+     * on the slots in ring order keeps the order the messages arrived in.
+     * Large messages are received separately once their announcement is next.
+     */
+    struct receive_ring final {
+        struct message {
+            int source;
+            int tag;
+            // valid until the next message is taken
+            std::span<std::byte> payload;
+        };
+
+        receive_ring(const lrt::message_channel& channel, std::size_t count)
+             : _channel(channel),
+               _buffers(count * channel.eager_limit),
+               _requests(count, MPI_REQUEST_NULL) {
+            for (std::size_t slot = 0; slot < count; ++slot) post(slot);
+        }
+
+        receive_ring(const receive_ring& cp) = delete;
+        receive_ring&
+        operator=(const receive_ring& cp) = delete;
+
+        ~receive_ring() noexcept {
+            for (std::size_t slot = 0; slot < _requests.size(); ++slot) {
+                if (slot == _head && _head_taken) continue;
+                MPI_Cancel(&_requests[slot]);
+                MPI_Wait(&_requests[slot], MPI_STATUS_IGNORE);
+            }
+        }
 
-        static manual_broadcast_handler
-        for_communicator(MPI_Comm comm) {
-            int rank;
-            int comm_size;
-            MPI_Comm_rank(comm, &rank);
-            MPI_Comm_size(comm, &comm_size);
-            return {rank, comm_size};
+        message
+        next() {
+            advance();
+            MPI_Status stat{};
+            MPI_Wait(&_requests[_head], &stat);
+            return take(stat);
+        }
+
+        /// Takes the next message only if it has already arrived.
+        std::optional<message>
+        poll() {
+            advance();
+            int arrived{};
+            MPI_Status stat{};
+            MPI_Test(&_requests[_head], &arrived, &stat);
+            if (arrived == 0) return std::nullopt;
+            return take(stat);
         }
 
     private:
-        manual_broadcast_handler(const int rank, const int size)
-             : _myrank(rank),
-               _size(static_cast<std::size_t>(size)) { }
-
-        [[nodiscard]] std::vector<int>
-        get_recipients() const {
-            std::vector<int> recipient_ranks(_size - 1);
-            std::ranges::generate(recipient_ranks, [idx = 0, skipped = _myrank]() mutable {
-                const auto rank = idx++;
-                if (rank == skipped) return idx++;
-                return rank;
-            });
-            return recipient_ranks;
+        void
+        advance() {
+            if (!_head_taken) return;
+            post(_head);
+            _head = (_head + 1) % _requests.size();
+            _head_taken = false;
         }
 
-        [[nodiscard]] std::vector<MPI_Request>
-        broadcast_with_tag(int tag, std::span<std::byte> bytes) const {
-            std::vector requests(_size, MPI_REQUEST_NULL);
-            const auto recipient_ranks = get_recipients();
-            std::transform(std::execution::par_unseq,
-                           recipient_ranks.begin(),
-                           recipient_ranks.end(),
-                           requests.begin(),
-                           [bytes, tag](int rank) {
-                               return start_send_buffer_to_with_tag(bytes, rank, tag);
-                           });
+        message
+        take(const MPI_Status& stat) {
+            _head_taken = true;
+            if ((stat.MPI_TAG & lrt::message_channel::large_message_flag) != 0) {
+                const auto tag = stat.MPI_TAG & ~lrt::message_channel::large_message_flag;
+                MPI_Status bulk_stat{};
+                MPI_Probe(stat.MPI_SOURCE, tag, _channel.bulk_comm, &bulk_stat);
+                int len;
+                MPI_Get_count(&bulk_stat, MPI_CHAR, &len);
+                _large.resize(static_cast<std::size_t>(len));
+                MPI_Recv(_large.data(), len, MPI_CHAR, stat.MPI_SOURCE, tag, _channel.bulk_comm, MPI_STATUS_IGNORE);
+                return {stat.MPI_SOURCE, tag, _large};
+            }
 
-            return requests;
+            int len;
+            MPI_Get_count(&stat, MPI_CHAR, &len);
+            return {stat.MPI_SOURCE, stat.MPI_TAG, slot_buffer(_head).first(static_cast<std::size_t>(len))};
         }
 
-        friend mpi_request_vector_awaiter
-        broadcast_insert(const manual_broadcast_handler& handler,
-                         const ldb::lv::linda_tuple& tuple) {
-            auto [val, val_sz] = lrt::serialize(tuple);
-            auto reqs = handler.broadcast_with_tag(LINDA_RT_DB_SYNC_INSERT_TAG,
-                                                   {val.get(), val_sz});
-            return {std::move(reqs), std::move(val)};
+        [[nodiscard]] std::span<std::byte>
+        slot_buffer(std::size_t slot) noexcept {
+            return std::span(_buffers).subspan(slot * _channel.eager_limit, _channel.eager_limit);
+        }
+
+        void
+        post(std::size_t slot) {
+            const auto buffer = slot_buffer(slot);
+            MPI_Irecv(buffer.data(),
+                      static_cast<int>(buffer.size()),
+                      MPI_CHAR,
+                      MPI_ANY_SOURCE,
+                      MPI_ANY_TAG,
+                      _channel.comm,
+                      &_requests[slot]);
+        }
+
+        const lrt::message_channel& _channel;
+        std::vector<std::byte> _buffers;
+        std::vector<MPI_Request> _requests;
+        std::size_t _head{};
+        // whether the message of the head slot was handed out, so it can be posted again
+        bool _head_taken{};
+        std::vector<std::byte> _large;
+    };
+
+    /**
+     * The insertions and deletions of this rank not yet sent. Operations are
+     * appended to the open frame, which is sent down the tree of this rank
+     * when it grows too large, or when an operation in it is awaited. While a
+     * frame is being sent, other threads keep appending to the next one, so
+     * concurrent operations share messages.
+     */
+    struct broadcast_frames final {
+        constexpr const static std::size_t max_frame_bytes = 16 * 1024;
+
+        broadcast_frames(lrt::message_channel& channel, int rank, std::vector<int> children)
+             : _channel(channel),
+               _rank(rank),
+               _children(std::move(children)),
+               _open_frame(encode_broadcast(rank, nullptr)) { }
+
+        [[nodiscard]] bool
+        has_recipients() const noexcept { return !_children.empty(); }
+
+        /// Appends an operation to the open frame; returns the sequence number of its frame.
+        std::uint64_t
+        append(frame_op op, ldb::data::tuple_id id, const ldb::lv::linda_tuple* tuple) {
+            const auto op_size = FRAME_OP_HEADER_SIZE + (tuple ? sizeof(std::uint32_t) : 0);
+            std::uint64_t seq;
+            bool full;
+            {
+                std::scoped_lock<std::mutex> lck(_append_mtx);
+                const auto offset = _open_frame.size();
+                _open_frame.resize(offset + op_size);
+                auto* out = _open_frame.data() + offset;
+                write_raw(out, static_cast<std::uint8_t>(op));
+                write_raw(out, id.origin);
+                write_raw(out, id.sequence);
+                if (tuple) {
+                    // the tuple is serialized in place, its length filled in after
+                    const auto val_sz = lrt::serialize_into(_open_frame, *tuple);
+                    out = _open_frame.data() + offset + FRAME_OP_HEADER_SIZE;
+                    write_raw(out, static_cast<std::uint32_t>(val_sz));
+                }
+
+                seq = _open_seq;
+                full = _open_frame.size() >= max_frame_bytes;
+            }
+            if (full) flush(seq);
+            return seq;
+        }
+
+        /// Returns once the frame with sequence number seq has been sent.
+        void
+        flush(std::uint64_t seq) {
+            std::scoped_lock<std::mutex> lck(_send_mtx);
+            if (seq < _sent_seq) return;
+
+            std::vector<std::byte> frame;
+            {
+                std::scoped_lock<std::mutex> append_lck(_append_mtx);
+                frame = std::exchange(_open_frame, encode_broadcast(_rank, nullptr));
+                ++_open_seq;
+            }
+
+            _channel.wait(*_channel.start_replication(std::move(frame), _children, LINDA_RT_DB_SYNC_FRAME_TAG));
+            _sent_seq = seq + 1;
         }
 
-        friend mpi_request_vector_awaiter
-        broadcast_delete(const manual_broadcast_handler& handler,
+    private:
+        // owned by the runtime, which outlives its store
+        lrt::message_channel& _channel;
+        int _rank;
+        std::vector<int> _children;
+
+        std::mutex _append_mtx;
+        std::vector<std::byte> _open_frame;
+        std::uint64_t _open_seq{};
+
+        std::mutex _send_mtx;
+        // every frame before this one has been sent
+        std::uint64_t _sent_seq{};
+    };
+
+    struct frame_awaiter final {
+        std::shared_ptr<broadcast_frames> frames;
+        std::uint64_t seq;
+
+    private:
+        friend void
+        await(const frame_awaiter& awaiter) {
+            if (awaiter.frames) awaiter.frames->flush(awaiter.seq);
+        }
+    };
+    static_assert(ldb::awaitable<frame_awaiter>);
+
+    struct coalescing_broadcaster final {
+        using await_type = frame_awaiter;
+
+        static coalescing_broadcaster
+        for_channel(lrt::message_channel& channel, int rank, std::vector<int> children) {
+            return coalescing_broadcaster(std::make_shared<broadcast_frames>(channel, rank, std::move(children)));
+        }
+
+    private:
+        explicit coalescing_broadcaster(std::shared_ptr<broadcast_frames> frames)
+             : _frames(std::move(frames)) { }
+
+        [[nodiscard]] frame_awaiter
+        append(frame_op op, ldb::data::tuple_id id, const ldb::lv::linda_tuple* tuple) const {
+            if (!_frames->has_recipients()) return {nullptr, 0};
+            return {_frames, _frames->append(op, id, tuple)};
+        }
+
+        friend frame_awaiter
+        broadcast_insert(const coalescing_broadcaster& bcast,
+                         ldb::data::tuple_id id,
                          const ldb::lv::linda_tuple& tuple) {
-            auto [val, val_sz] = lrt::serialize(tuple);
-            auto reqs = handler.broadcast_with_tag(LINDA_RT_DB_SYNC_DELETE_TAG,
-                                                   {val.get(), val_sz});
-            return {std::move(reqs), std::move(val)};
+            return bcast.append(frame_op::insert, id, &tuple);
+        }
+
+        friend frame_awaiter
+        broadcast_delete(const coalescing_broadcaster& bcast,
+                         ldb::data::tuple_id id) {
+            return bcast.append(frame_op::remove, id, nullptr);
         }
 
-        int _myrank;
-        std::size_t _size;
+        std::shared_ptr<broadcast_frames> _frames;
     };
+    static_assert(ldb::broadcaster<coalescing_broadcaster>);
 
     struct incompatible_mpi_exception : std::runtime_error {
-        incompatible_mpi_exception()
-             : std::runtime_error("MPI_Init_thread: insufficient threading capabilities: "
-                                  "LindaRT requires at least MPI_THREAD_SERIALIZED but the current "
-                                  "MPI runtime cannot provide this functionality.") { }
+        explicit incompatible_mpi_exception(const char* required)
+             : std::runtime_error(std::string("MPI_Init_thread: insufficient threading capabilities: "
+                                              "LindaRT requires at least ")
+                                  + required
+                                  + " but the current MPI runtime cannot provide this functionality.") { }
     };
 
     void
-    init_threaded_mpi(int* argc, char*** argv) {
+    init_threaded_mpi(int* argc, char*** argv, lrt::mpi_threading threading) {
+        const auto funneled = threading == lrt::mpi_threading::funneled;
         int got_thread = MPI_THREAD_SINGLE;
-        MPI_Init_thread(argc, argv, MPI_THREAD_MULTIPLE, &got_thread);
+        MPI_Init_thread(argc, argv, funneled ? MPI_THREAD_FUNNELED : MPI_THREAD_MULTIPLE, &got_thread);
 
-        if (got_thread == MPI_THREAD_SINGLE
-            || got_thread == MPI_THREAD_FUNNELED) throw incompatible_mpi_exception();
+        // the levels are ordered by what they allow
+        if (got_thread < (funneled ? MPI_THREAD_FUNNELED : MPI_THREAD_SERIALIZED)) {
+            throw incompatible_mpi_exception(funneled ? "MPI_THREAD_FUNNELED" : "MPI_THREAD_SERIALIZED");
+        }
     }
 }
 
-lrt::runtime::runtime(int* argc, char*** argv)
-     : _recv_thr(&lrt::runtime::recv_thread_worker, this) {
-    if (!_mpi_inited.test_and_set()) init_threaded_mpi(argc, argv);
+lrt::runtime::runtime(int* argc,
+                      char*** argv,
+                      distribution mode,
+                      receive_options options,
+                      mpi_threading threading)
+     : _mode(mode),
+       _options(options),
+       _threading(threading) {
+    if (_threading == mpi_threading::multiple) {
+        init_mpi(argc, argv);
+        _recv_thr = std::thread(&lrt::runtime::recv_thread_worker, this, argc, argv);
+        return;
+    }
 
-    MPI_Comm_rank(MPI_COMM_WORLD, &_rank);
-    _store.set_broadcast(manual_broadcast_handler::for_communicator(MPI_COMM_WORLD));
-    _recv_start.test_and_set();
-    _recv_start.notify_all();
+    // MPI only takes calls from the thread which initialized it
+    _recv_thr = std::thread(&lrt::runtime::recv_thread_worker, this, argc, argv);
+    _mpi_ready.wait(false);
+    if (_init_error) {
+        _recv_thr.join();
+        std::rethrow_exception(_init_error);
+    }
 }
 
 lrt::runtime::~runtime() noexcept {
-    constexpr char buf{};
-    MPI_Send(&buf, 0, MPI_CHAR, _rank, LINDA_RT_TERMINATE_TAG, MPI_COMM_WORLD);
+    if (_threading == mpi_threading::funneled) {
+        // the communication thread synchronizes with the others and finalizes MPI on its own
+        _channel->send({}, _rank, LINDA_RT_TERMINATE_TAG);
+        _recv_thr.join();
+        return;
+    }
+
+    // owners and node leaders have to keep serving the others until every rank is done with the space
+    if (_mode != distribution::replicated) MPI_Barrier(MPI_COMM_WORLD);
+
+    // the flush follows the broadcasts of this rank down the same tree: once
+    // a rank got the flush of every other rank, it got and relayed all of their broadcasts
+    if (holds_replica()) {
+        track(_channel->start_replication(encode_broadcast(_rank, nullptr), broadcast_children(_rank), LINDA_RT_FLUSH_TAG));
+    }
+
+    _channel->send({}, _rank, LINDA_RT_TERMINATE_TAG);
     _recv_thr.join();
+    for (auto& send : _sends) _channel->wait(*send);
     MPI_Barrier(MPI_COMM_WORLD);
+    _channel->rings.reset();
+    MPI_Comm_free(&_channel->bulk_comm);
     MPI_Finalize();
 }
 
 void
-lrt::runtime::recv_thread_worker() {
-    _recv_start.wait(false);
-    for (;;) {
-        MPI_Status stat{};
-        MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &stat);
-
-        int len;
-        MPI_Get_count(&stat, MPI_CHAR, &len);
-        auto buf = std::vector<std::byte>(static_cast<std::size_t>(len));
-
-        MPI_Recv(buf.data(), len, MPI_CHAR, stat.MPI_SOURCE, stat.MPI_TAG, MPI_COMM_WORLD, &stat);
-        const auto command = stat.MPI_TAG;
-        const auto payload = std::span<std::byte>(buf);
-
-        switch (command) {
-        case LINDA_RT_DB_SYNC_INSERT_TAG: {
-            const auto rx_inserted = deserialize(payload);
-            std::osyncstream(std::cout) << "INSERT (" << stat.MPI_SOURCE << " -> " << _rank << "): " << rx_inserted << "\n";
-            _store.out_nosignal(rx_inserted);
+lrt::runtime::init_mpi(int* argc, char*** argv) {
+    if (!_mpi_inited.test_and_set()) init_threaded_mpi(argc, argv, _threading);
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &_size);
+    _leader = _rank;
+    _replicas.resize(static_cast<std::size_t>(_size));
+    std::iota(_replicas.begin(), _replicas.end(), 0);
+    if (_mode == distribution::node_shared) {
+        // the ranks able to share memory with this one are led by the first of them
+        MPI_Comm node_comm;
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, _rank, MPI_INFO_NULL, &node_comm);
+        MPI_Bcast(&_leader, 1, MPI_INT, 0, node_comm);
+        MPI_Comm_free(&node_comm);
+
+        MPI_Allgather(&_leader, 1, MPI_INT, _replicas.data(), 1, MPI_INT, MPI_COMM_WORLD);
+        std::ranges::sort(_replicas);
+        const auto [last, end] = std::ranges::unique(_replicas);
+        _replicas.erase(last, end);
+    }
+    _channel = std::make_unique<message_channel>(MPI_COMM_WORLD,
+                                                 _options.buffer_size,
+                                                 _threading == mpi_threading::funneled);
+    MPI_Comm_dup(MPI_COMM_WORLD, &_channel->bulk_comm);
+    if (_options.one_sided) _channel->rings = std::make_unique<rma_rings>(MPI_COMM_WORLD, _options.ring_size);
+    _store.set_origin(static_cast<std::uint32_t>(_rank));
+    if (holds_replica()) {
+        _store.set_broadcast(coalescing_broadcaster::for_channel(*_channel, _rank, broadcast_children(_rank)));
+    }
+}
+
+void
+lrt::runtime::barrier() {
+    _channel->wait(*_channel->start_barrier());
+}
+
+void
+lrt::runtime::out(const ldb::lv::linda_tuple& tuple) {
+    const auto owner = _mode == distribution::node_shared ? _leader
+                       : tuple.size() > 0                  ? owner_of(tuple[0])
+                                                           : 0;
+    if (_mode == distribution::replicated || owner == _rank) {
+        _store.out(tuple);
+        if (_mode != distribution::replicated) serve_waiting();
+        return;
+    }
+
+    std::vector<std::byte> message;
+    lrt::serialize_into(message, tuple);
+    _channel->send(std::move(message), owner, LINDA_RT_OWNER_INSERT_TAG);
+}
+
+int
+lrt::runtime::owner_of(const ldb::lv::linda_value& header) const noexcept {
+    return static_cast<int>(std::hash<ldb::lv::linda_value>{}(header) % static_cast<std::size_t>(_size));
+}
+
+std::vector<int>
+lrt::runtime::broadcast_children(int root) const {
+    // the tree is built over the positions of the replicas
+    const auto position = [this](int rank) {
+        return static_cast<int>(std::ranges::find(_replicas, rank) - _replicas.begin());
+    };
+    auto children = binomial_children(position(_rank), position(root), static_cast<int>(_replicas.size()));
+    for (auto& child : children) child = _replicas[static_cast<std::size_t>(child)];
+    return children;
+}
+
+std::optional<ldb::lv::linda_tuple>
+lrt::runtime::retrieve_remote(int rank,
+                              request_kind kind,
+                              const ldb::lv::linda_tuple& values,
+                              std::uint64_t formals) {
+    const auto id = _next_request_id.fetch_add(1, std::memory_order_relaxed);
+    auto reply = [this, id] {
+        std::scoped_lock<std::mutex> lck(_pending_mtx);
+        return _pending[id].get_future();
+    }();
+
+    auto request = encode_with_header(REQUEST_HEADER_SIZE, &values, [id, formals, kind](std::byte*& out) {
+        write_raw(out, id);
+        write_raw(out, formals);
+        write_raw(out, static_cast<std::uint8_t>(kind));
+    });
+    _channel->send(std::move(request), rank, LINDA_RT_REQUEST_TAG);
+    return reply.get();
+}
+
+void
+lrt::runtime::serve_request(int rank,
+                            std::uint64_t id,
+                            request_kind kind,
+                            const ldb::lv::linda_tuple& values,
+                            std::uint64_t formals) {
+    const ldb::store::query_type query = ldb::template_tuple_query<index_type>(values, formals);
+    const auto removes = kind == request_kind::in || kind == request_kind::inp;
+    if (kind == nonblocking(kind)) {
+        reply_request(rank, id, removes ? _store.inp(query) : _store.rdp(query));
+        return;
+    }
+
+    // checked under the lock of the waiters: a tuple added before is found
+    // here, one added after by serve_waiting
+    std::scoped_lock<std::mutex> lck(_waiting_mtx);
+    if (auto found = removes ? _store.inp(query) : _store.rdp(query)) {
+        reply_request(rank, id, found);
+        return;
+    }
+    _waiting.push_back({rank, id, removes, query});
+}
+
+void
+lrt::runtime::serve_waiting() {
+    std::scoped_lock<std::mutex> lck(_waiting_mtx);
+    // in order of arrival, so an earlier in takes the tuple before a later one
+    std::erase_if(_waiting, [this](const waiting_request& waiting) {
+        auto found = waiting.removes ? _store.inp(waiting.query) : _store.rdp(waiting.query);
+        if (!found) return false;
+        reply_request(waiting.rank, waiting.id, found);
+        return true;
+    });
+}
+
+void
+lrt::runtime::reply_request(int rank, std::uint64_t id, const std::optional<ldb::lv::linda_tuple>& found) {
+    post_sends({rank}, LINDA_RT_REPLY_TAG, encode_with_header(REPLY_HEADER_SIZE, found ? &*found : nullptr, [id, &found](std::byte*& out) {
+        write_raw(out, id);
+        write_raw(out, static_cast<std::uint8_t>(found.has_value()));
+    }));
+}
+
+void
+lrt::runtime::post_sends(std::vector<int> ranks, int tag, std::vector<std::byte>&& message) {
+    track(_channel->start(std::move(message), std::move(ranks), tag));
+}
+
+void
+lrt::runtime::track(std::shared_ptr<posted_operation> posted) {
+    std::scoped_lock<std::mutex> lck(_sends_mtx);
+    std::erase_if(_sends, [this](const std::shared_ptr<posted_operation>& sending) {
+        return _channel->test(*sending);
+    });
+    _sends.push_back(std::move(posted));
+}
+
+void
+lrt::runtime::relay_broadcast(int root, int tag, std::span<const std::byte> message) {
+    if (auto children = broadcast_children(root); !children.empty()) {
+        track(_channel->start_replication(std::vector(message.begin(), message.end()), std::move(children), tag));
+    }
+}
+
+void
+lrt::runtime::apply_frame(std::span<std::byte> frame) {
+    const auto root = read_raw<std::int32_t>(frame);
+    auto inserted = false;
+    while (!frame.empty()) {
+        const auto op = static_cast<frame_op>(read_raw<std::uint8_t>(frame));
+        const auto origin = read_raw<std::uint32_t>(frame);
+        const auto id = ldb::data::tuple_id{origin, read_raw<std::uint64_t>(frame)};
+        switch (op) {
+        case frame_op::insert: {
+            const auto tuple_size = read_raw<std::uint32_t>(frame);
+            const auto tuple = deserialize(frame.first(tuple_size));
+            frame = frame.subspan(tuple_size);
+            if (_options.trace) std::osyncstream(std::cout) << "INSERT (" << root << " -> " << _rank << "): " << tuple << "\n";
+            _store.out_nosignal(id, tuple);
+            inserted = true;
             break;
         }
-
-        case LINDA_RT_DB_SYNC_DELETE_TAG: {
-            const auto rx_deleted = deserialize(payload);
-            std::osyncstream(std::cout) << "REMOVE (" << stat.MPI_SOURCE << " -> " << _rank << "): " << rx_deleted << "\n";
-            _store.remove_nosignal(rx_deleted);
+        case frame_op::remove:
+            if (_options.trace) {
+                std::osyncstream(std::cout) << "REMOVE (" << root << " -> " << _rank << "): "
+                                            << id.origin << ":" << id.sequence << "\n";
+            }
+            _store.remove_nosignal(id);
             break;
         }
+    }
+    // node leaders also serve the ranks of their node with the tuples of the other nodes
+    if (inserted && _mode == distribution::node_shared) serve_waiting();
+}
 
-        case LINDA_RT_TERMINATE_TAG:
-            return;
+void
+lrt::runtime::apply_received(int source, int tag, std::span<std::byte> payload) {
+    switch (tag) {
+    case LINDA_RT_DB_SYNC_FRAME_TAG:
+        apply_frame(payload);
+        break;
 
-        default:
-            std::cerr << "ERROR: unknown command received ("
-                      << std::showbase << std::hex << command << std::dec << std::noshowbase
-                      << ")\n";
+    case LINDA_RT_OWNER_INSERT_TAG: {
+        const auto rx_inserted = deserialize(payload);
+        if (_options.trace) std::osyncstream(std::cout) << "INSERT (" << source << " -> " << _rank << "): " << rx_inserted << "\n";
+        // the owner holds the only copy, or the node leader the replica of the node: it names the tuple itself
+        _store.out(rx_inserted);
+        serve_waiting();
+        break;
+    }
+
+    case LINDA_RT_REQUEST_TAG: {
+        auto request = payload;
+        const auto id = read_raw<std::uint64_t>(request);
+        const auto formals = read_raw<std::uint64_t>(request);
+        const auto kind = static_cast<request_kind>(read_raw<std::uint8_t>(request));
+        serve_request(source, id, kind, deserialize(request), formals);
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+void
+lrt::runtime::recv_thread_worker(int* argc, char*** argv) {
+    const auto funneled = _threading == mpi_threading::funneled;
+    if (funneled) {
+        try {
+            init_mpi(argc, argv);
+        } catch (...) {
+            _init_error = std::current_exception();
+        }
+        _mpi_ready.test_and_set();
+        _mpi_ready.notify_all();
+        if (_init_error) return;
+    }
+
+    auto terminating = false;
+    auto awaited_flushes = holds_replica() ? static_cast<int>(_replicas.size()) - 1 : 0;
+    auto shutdown_barrier = MPI_REQUEST_NULL;
+    std::vector<std::shared_ptr<posted_operation>> in_flight;
+    {
+        receive_ring ring(*_channel, _options.buffer_count);
+
+        // the operations of an origin always go to the same lane, so they are applied in order
+        using lane_type = ldb::data::spsc_queue<received_operation>;
+        std::vector<std::unique_ptr<lane_type>> lanes;
+        std::vector<std::thread> appliers;
+        // a node leader broadcasts what its node asks for, which must not hold up this thread;
+        // funneled, this thread completes every send, so it must not wait on a store lock
+        // held by an application thread which in turn waits for its broadcast to be sent
+        const auto workers = _mode == distribution::node_shared || funneled
+                                    ? std::max<std::size_t>(_options.apply_workers, 1)
+                                    : _options.apply_workers;
+        for (std::size_t i = 0; i < workers; ++i) {
+            auto& lane = *lanes.emplace_back(std::make_unique<lane_type>(APPLY_LANE_CAPACITY));
+            appliers.emplace_back([this, &lane] {
+                for (auto op = lane.pop(); !op.payload.empty(); op = lane.pop()) {
+                    apply_received(op.source, op.tag, op.payload);
+                }
+            });
+        }
+
+        auto dispatch = [&](int origin, int source, int tag, std::span<std::byte> payload) {
+            if (lanes.empty()) {
+                apply_received(source, tag, payload);
+                return;
+            }
+            auto& lane = *lanes[static_cast<std::size_t>(origin) % lanes.size()];
+            received_operation op{source, tag, std::vector(payload.begin(), payload.end())};
+            if (!funneled) {
+                lane.push(std::move(op));
+                return;
+            }
+            // the applier may be held up by a thread waiting for a send of this one
+            while (!lane.try_push(std::move(op))) _channel->progress(in_flight);
+        };
+
+        auto handle = [&](const receive_ring::message& received) {
+            const auto [source, command, payload] = received;
+
+            switch (command) {
+            case LINDA_RT_DB_SYNC_FRAME_TAG: {
+                auto message = payload;
+                const auto root = read_raw<std::int32_t>(message);
+                relay_broadcast(root, command, payload);
+                dispatch(root, source, command, payload);
+                break;
+            }
+
+            case LINDA_RT_OWNER_INSERT_TAG:
+            case LINDA_RT_REQUEST_TAG:
+                dispatch(source, source, command, payload);
+                break;
+
+            case LINDA_RT_FLUSH_TAG: {
+                auto message = payload;
+                const auto root = read_raw<std::int32_t>(message);
+                relay_broadcast(root, command, payload);
+                --awaited_flushes;
+                break;
+            }
+
+            case LINDA_RT_REPLY_TAG: {
+                auto reply = payload;
+                const auto id = read_raw<std::uint64_t>(reply);
+                const auto found = read_raw<std::uint8_t>(reply) != 0;
+
+                std::scoped_lock<std::mutex> lck(_pending_mtx);
+                const auto it = _pending.find(id);
+                assert_that(it != _pending.end());
+                it->second.set_value(found ? std::optional(deserialize(reply)) : std::nullopt);
+                _pending.erase(it);
+                break;
+            }
+
+            case LINDA_RT_TERMINATE_TAG:
+                terminating = true;
+                if (!funneled) break;
+
+                // what the destructor does on the other threads, without blocking this one
+                if (_mode != distribution::replicated) MPI_Ibarrier(MPI_COMM_WORLD, &shutdown_barrier);
+                if (holds_replica()) {
+                    track(_channel->start_replication(encode_broadcast(_rank, nullptr), broadcast_children(_rank), LINDA_RT_FLUSH_TAG));
+                }
+                break;
+
+            default:
+                std::cerr << "ERROR: unknown command received ("
+                          << std::showbase << std::hex << command << std::dec << std::noshowbase
+                          << ")\n";
+            }
+        };
+
+        if (!funneled && !_channel->rings) {
+            while (!terminating || awaited_flushes > 0) handle(ring.next());
         }
+        else {
+            // nothing may block here: this thread also carries the sends of the
+            // others, or has to look at the replication rings between messages
+            while (!terminating || awaited_flushes > 0 || shutdown_barrier != MPI_REQUEST_NULL) {
+                auto progressed = _channel->progress(in_flight);
+                if (auto received = ring.poll()) {
+                    handle(*received);
+                    progressed = true;
+                }
+                if (_channel->rings
+                    && _channel->rings->poll([&handle](int source, int tag, std::span<std::byte> payload) {
+                           handle({source, tag, payload});
+                       })) progressed = true;
+                if (shutdown_barrier != MPI_REQUEST_NULL) {
+                    int passed{};
+                    MPI_Test(&shutdown_barrier, &passed, MPI_STATUS_IGNORE);
+                }
+                if (!progressed) std::this_thread::yield();
+            }
+        }
+
+        for (auto& lane : lanes) lane->push({});
+        for (auto& applier : appliers) applier.join();
     }
+    if (!funneled) return;
+
+    while (_channel->progress(in_flight) || !in_flight.empty()) std::this_thread::yield();
+    MPI_Barrier(MPI_COMM_WORLD);
+    _channel->rings.reset();
+    MPI_Comm_free(&_channel->bulk_comm);
+    MPI_Finalize();
 }
@@ -37,16 +37,15 @@
 #include <algorithm>
 #include <array>
 #include <bit>
-#include <cassert>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
-#include <execution>
+#include <cstring>
 #include <limits>
 #include <memory>
-#include <numeric>
 #include <span>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <variant>
@@ -59,6 +58,15 @@
 
 #include "ldb/lv/fn_call_holder.hxx"
 
+/*
+ * A serialized tuple is a marker byte followed by the tuple:
+ *   tuple:  [varint field count][field...]
+ *   field:  [u8 typemap][value]
+ * where integers and all lengths are LEB128 varints, signed integers
+ * zigzag-encoded first, so small numbers take a single byte. Floating point
+ * values and the elements of arrays keep their fixed width, in the
+ * communication byte order.
+ */
 namespace {
     template<class T>
     struct fail {
@@ -110,40 +118,9 @@ namespace {
         }
     }
 
-    std::size_t
-    calculate_tuple_serial_size(const ldb::lv::linda_tuple& tuple);
-
-    struct value_size_calculator {
-        std::size_t buf = 0;
-
-        void
-        operator()(std::int16_t /*ignore*/) { buf = sizeof(std::int16_t); }
-        void
-        operator()(std::uint16_t /*ignore*/) { buf = sizeof(std::uint16_t); }
-        void
-        operator()(std::int32_t /*ignore*/) { buf = sizeof(std::int32_t); }
-        void
-        operator()(std::uint32_t /*ignore*/) { buf = sizeof(std::uint32_t); }
-        void
-        operator()(std::int64_t /*ignore*/) { buf = sizeof(std::int64_t); }
-        void
-        operator()(std::uint64_t /*ignore*/) { buf = sizeof(std::uint64_t); }
-        void
-        operator()(const std::string& str) { buf = sizeof(std::string::size_type) + str.size(); }
-        void
-        operator()(float /*ignore*/) { buf = sizeof(float); }
-        void
-        operator()(double /*ignore*/) { buf = sizeof(double); }
-        void
-        operator()(const ldb::lv::fn_call_holder& fn_call_holder) {
-            const auto tuple_with_length_sz = calculate_tuple_serial_size(fn_call_holder.args());
-            const auto fn_name_sz = fn_call_holder.fn_name().size();
-            const auto fn_name_length_sz = sizeof(std::string::size_type);
-            buf = tuple_with_length_sz + fn_name_length_sz + fn_name_sz;
-        }
-        void
-        operator()(ldb::lv::fn_call_tag /*ignore*/) { buf = 0; }
-    };
+    // the unsigned integer with the representation of a float
+    template<std::floating_point T>
+    using float_bits_t = std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
 
     enum class typemap : std::uint8_t {
         LRT_INT16 = 0,
@@ -157,6 +134,12 @@ namespace {
         LRT_DOUBLE = 8,
         LRT_FNCALL = 9,
         LRT_CALLTAG = 10,
+        LRT_SYMBOL = 11,
+        LRT_BYTES = 12,
+        LRT_INT32_ARRAY = 13,
+        LRT_INT64_ARRAY = 14,
+        LRT_FLOAT_ARRAY = 15,
+        LRT_DOUBLE_ARRAY = 16,
     };
 
     template<class>
@@ -186,7 +169,7 @@ namespace {
         constexpr const static auto value = static_cast<std::byte>(typemap::LRT_UINT64);
     };
     template<>
-    struct to_typemap<std::string> {
+    struct to_typemap<ldb::lv::linda_string> {
         constexpr const static auto value = static_cast<std::byte>(typemap::LRT_STRING);
     };
     template<>
@@ -205,231 +188,290 @@ namespace {
     struct to_typemap<ldb::lv::fn_call_tag> {
         constexpr const static auto value = static_cast<std::byte>(typemap::LRT_CALLTAG);
     };
+    template<>
+    struct to_typemap<ldb::lv::linda_symbol> {
+        constexpr const static auto value = static_cast<std::byte>(typemap::LRT_SYMBOL);
+    };
+    template<>
+    struct to_typemap<ldb::lv::linda_bytes> {
+        constexpr const static auto value = static_cast<std::byte>(typemap::LRT_BYTES);
+    };
+    template<>
+    struct to_typemap<ldb::lv::linda_array<std::int32_t>> {
+        constexpr const static auto value = static_cast<std::byte>(typemap::LRT_INT32_ARRAY);
+    };
+    template<>
+    struct to_typemap<ldb::lv::linda_array<std::int64_t>> {
+        constexpr const static auto value = static_cast<std::byte>(typemap::LRT_INT64_ARRAY);
+    };
+    template<>
+    struct to_typemap<ldb::lv::linda_array<float>> {
+        constexpr const static auto value = static_cast<std::byte>(typemap::LRT_FLOAT_ARRAY);
+    };
+    template<>
+    struct to_typemap<ldb::lv::linda_array<double>> {
+        constexpr const static auto value = static_cast<std::byte>(typemap::LRT_DOUBLE_ARRAY);
+    };
+
+    // the longest LEB128 encoding of a 64-bit value
+    constexpr const std::size_t max_varint_size = 10;
 
-    std::size_t
-    tuple_serialize_into(std::byte* buf,
-                         const ldb::lv::linda_tuple& tuple);
+    template<std::signed_integral T>
+    constexpr std::make_unsigned_t<T>
+    zigzag_encode(T val) noexcept {
+        using U = std::make_unsigned_t<T>;
+        return static_cast<U>((static_cast<U>(val) << 1U) ^ static_cast<U>(val >> (std::numeric_limits<T>::digits)));
+    }
+
+    template<std::signed_integral T>
+    constexpr T
+    zigzag_decode(std::make_unsigned_t<T> val) noexcept {
+        return static_cast<T>((val >> 1U) ^ (~(val & 1U) + 1U));
+    }
 
+    /// Appends the serialized form of values to the end of its buffer, in one pass.
     struct value_serializator {
         static_assert(std::numeric_limits<float>::is_iec559,
                       "LindaRT requires IEEE754 floats");
         static_assert(std::numeric_limits<double>::is_iec559,
                       "LindaRT requires IEEE754 doubles");
 
-        explicit value_serializator(std::byte* buf) : buf(buf) { }
-        std::byte* buf;
+        explicit value_serializator(std::vector<std::byte>& buf) : buf(buf) { }
+        std::vector<std::byte>& buf;
 
         template<std::integral T>
-        std::size_t
+        void
         operator()(T val) const {
-            buf[0] = to_typemap<T>::value;
-            return 1 + write_int_raw(val, buf + 1);
+            buf.push_back(to_typemap<T>::value);
+            write_int(val);
         }
 
         template<std::floating_point T>
-        std::size_t
+        void
         operator()(T val) const {
-            buf[0] = to_typemap<T>::value;
-            return 1 + write_float_raw(val, buf + 1);
+            buf.push_back(to_typemap<T>::value);
+            write_bytes(std::bit_cast<std::array<std::byte, sizeof(T)>>(swap_unless_comm_endian(std::bit_cast<float_bits_t<T>>(val))));
         }
 
-        std::size_t
-        operator()(const std::string& str) const {
-            buf[0] = to_typemap<std::string>::value;
-            return 1 + write_string_raw(str, buf + 1);
+        void
+        operator()(const ldb::lv::linda_string& str) const {
+            buf.push_back(to_typemap<ldb::lv::linda_string>::value);
+            write_string(str.view());
         }
 
-        std::size_t
+        void
         operator()(const ldb::lv::fn_call_holder& fn_call_holder) const {
-            auto my_buf = buf;
-            *(my_buf++) = to_typemap<ldb::lv::fn_call_holder>::value;
-
-            my_buf += tuple_serialize_into(my_buf, fn_call_holder.args());
-            my_buf += write_string_raw(fn_call_holder.fn_name(), my_buf);
-
-            return static_cast<std::size_t>(my_buf - buf);
+            buf.push_back(to_typemap<ldb::lv::fn_call_holder>::value);
+            write_tuple(fn_call_holder.args());
+            write_string(fn_call_holder.fn_name());
         }
 
-        std::size_t
+        void
         operator()(ldb::lv::fn_call_tag /*ignore*/) const {
-            buf[0] = to_typemap<ldb::lv::fn_call_tag>::value;
-            return 1;
+            buf.push_back(to_typemap<ldb::lv::fn_call_tag>::value);
         }
 
-        template<std::integral T>
-        static std::size_t
-        write_int_raw(T val, std::byte* buf) {
-            auto value_representation =
-                   std::bit_cast<std::array<std::byte, sizeof(std::remove_cvref_t<T>)>>(swap_unless_comm_endian(val));
-            return write_bytes_raw(value_representation.begin(), value_representation.end(), buf);
+        void
+        operator()(ldb::lv::linda_symbol sym) const {
+            // symbols are process-local: they travel as text, and get interned on receipt
+            buf.push_back(to_typemap<ldb::lv::linda_symbol>::value);
+            write_string(sym.view());
         }
 
-    private:
-        template<std::floating_point T>
-        static std::size_t
-        write_float_raw(T val, std::byte* buf) {
-            auto value_representation =
-                   std::bit_cast<std::array<std::byte, sizeof(std::remove_cvref_t<T>)>>(val);
-            return write_bytes_raw(value_representation.begin(), value_representation.end(), buf);
+        template<class T>
+        void
+        operator()(const ldb::lv::linda_array<T>& arr) const {
+            buf.push_back(to_typemap<ldb::lv::linda_array<T>>::value);
+            write_varint(arr.size());
+            write_array(arr.span());
         }
 
-        template<std::input_iterator It, std::sentinel_for<It> S>
-        static std::size_t
-        write_bytes_raw(It begin, S end, std::byte* buf) {
-            const auto copied_end = std::copy(std::execution::par_unseq,
-                                              begin,
-                                              end,
-                                              buf);
-            return static_cast<std::size_t>(copied_end - buf);
+        void
+        write_tuple(const ldb::lv::linda_tuple& tuple) const {
+            write_varint(tuple.size());
+            for (const auto& val : tuple) std::visit(*this, val);
         }
 
-        static std::size_t
-        write_string_raw(std::string_view str, std::byte* buf) {
-            const auto length_sz = write_int_raw(str.size(), buf);
-            std::transform(std::execution::par_unseq,
-                           str.data(),
-                           str.data() + str.size(),
-                           buf + sizeof(std::string::size_type),
-                           [](const char c) {
-                               return static_cast<std::byte>(c);
-                           });
-            return length_sz + str.size();
+    private:
+        void
+        write_varint(std::uint64_t val) const {
+            std::array<std::byte, max_varint_size> encoded;
+            std::size_t len = 0;
+            for (; val >= 0x80U; val >>= 7U) encoded[len++] = static_cast<std::byte>(val | 0x80U);
+            encoded[len++] = static_cast<std::byte>(val);
+            buf.insert(buf.end(), encoded.begin(), encoded.begin() + static_cast<std::ptrdiff_t>(len));
         }
-    };
-
-    std::size_t
-    calculate_value_serial_size(const ldb::lv::linda_value& val) {
-        value_size_calculator calc;
-        std::visit(calc, val);
-        return 1 + calc.buf; // 1 byte header
-    }
-
-    std::size_t
-    calculate_tuple_serial_size(const ldb::lv::linda_tuple& tuple) {
-        const auto size = sizeof(std::size_t); // tuple len
-        std::vector<std::size_t> buf(tuple.size(), std::size_t{});
-        std::iota(buf.begin(), buf.end(), std::size_t{});
-        std::transform(std::execution::par_unseq, buf.begin(), buf.end(), buf.begin(), [&tuple](std::size_t i) {
-            return calculate_value_serial_size(tuple[i]);
-        });
-        return size + std::reduce(std::execution::par_unseq, buf.begin(), buf.end());
-    }
 
-    std::size_t
-    value_serialize(std::byte* buf,
-                    const ldb::lv::linda_value& val) {
-        return std::visit(value_serializator{buf}, val);
-    }
+        template<std::integral T>
+        void
+        write_int(T val) const {
+            if constexpr (std::signed_integral<T>) {
+                write_varint(zigzag_encode(val));
+            }
+            else {
+                write_varint(val);
+            }
+        }
 
-    std::size_t
-    tuple_serialize_into(std::byte* buf,
-                         const ldb::lv::linda_tuple& tuple) {
-        const std::size_t i = value_serializator::write_int_raw(tuple.size(), buf);
-        return std::accumulate(tuple.begin(), tuple.end(), i, [buf](auto acc, const auto& val) {
-            return acc + value_serialize(buf + acc, val);
-        });
-    }
+        void
+        write_bytes(std::span<const std::byte> bytes) const {
+            buf.insert(buf.end(), bytes.begin(), bytes.end());
+        }
 
-    std::pair<std::unique_ptr<std::byte[]>, std::size_t>
-    tuple_serialize(const ldb::lv::linda_tuple& val) {
-        const auto serial_size = calculate_tuple_serial_size(val) + 1;
-        auto buf = std::make_unique<std::byte[]>(serial_size);
-        buf[0] = std::byte{1};
+        template<class T>
+        void
+        write_array(std::span<const T> vals) const {
+            const auto offset = buf.size();
+            buf.resize(offset + vals.size_bytes());
+            auto* out = buf.data() + offset;
+            if constexpr (std::integral<T> && sizeof(T) > 1) {
+                // a plain copy, unless the host is not of the communication endianness
+                for (std::size_t i = 0; i < vals.size(); ++i) {
+                    const auto val = swap_unless_comm_endian(vals[i]);
+                    std::memcpy(out + i * sizeof(T), &val, sizeof(T));
+                }
+            }
+            else {
+                std::memcpy(out, vals.data(), vals.size_bytes());
+            }
+        }
 
-        tuple_serialize_into(buf.get() + 1, val);
+        void
+        write_string(std::string_view str) const {
+            write_varint(str.size());
+            write_bytes(std::as_bytes(std::span(str)));
+        }
+    };
 
-        return std::make_pair(std::move(buf), serial_size);
-    }
+    /// Reads serialized values from the front of its buffer.
+    struct value_deserializator {
+        std::span<const std::byte> buf;
+
+        std::uint64_t
+        read_varint() {
+            std::uint64_t val{};
+            for (unsigned shift = 0;; shift += 7U) {
+                assert_that(!buf.empty() && shift < 64);
+                const auto byte = std::to_integer<std::uint64_t>(buf.front());
+                buf = buf.subspan(1);
+                val |= (byte & 0x7FU) << shift;
+                if ((byte & 0x80U) == 0) return val;
+            }
+        }
 
-    template<std::constructible_from T>
-    T
-    deserialize_numeric(std::byte*& buf, std::size_t& len) {
-        assert_that(len >= sizeof(T));
-        T i{};
-        auto value_representation =
-               std::bit_cast<std::byte*>(&i);
-        std::copy(std::execution::par_unseq,
-                  buf,
-                  buf + sizeof(T),
-                  value_representation);
-        len -= sizeof(T);
-        buf += sizeof(T);
-        if constexpr (std::integral<T>) {
-            return swap_unless_comm_endian(i);
+        template<std::integral T>
+        T
+        read_int() {
+            if constexpr (std::signed_integral<T>) {
+                return zigzag_decode<T>(static_cast<std::make_unsigned_t<T>>(read_varint()));
+            }
+            else {
+                return static_cast<T>(read_varint());
+            }
         }
-        else {
-            return i;
+
+        template<std::floating_point T>
+        T
+        read_float() {
+            float_bits_t<T> bits;
+            std::memcpy(&bits, take(sizeof(T)).data(), sizeof(T));
+            return std::bit_cast<T>(swap_unless_comm_endian(bits));
         }
-    }
 
-    std::string
-    deserialize_string(std::byte*& buf, std::size_t& len) {
-        const auto str_sz = deserialize_numeric<std::string::size_type>(buf, len);
-        assert_that(len >= str_sz);
-        std::string str(str_sz, '.');
-        std::transform(std::execution::par_unseq,
-                       buf,
-                       buf + str_sz,
-                       str.data(),
-                       [](std::byte b) {
-                           return static_cast<char>(b);
-                       });
-        len -= str_sz;
-        buf += str_sz;
-        return str;
-    }
+        std::string_view
+        read_string_view() {
+            const auto bytes = take(static_cast<std::size_t>(read_varint()));
+            return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+        }
 
-    ldb::lv::linda_tuple
-    tuple_deserialize(std::byte*& buf, std::size_t& len);
-
-    ldb::lv::linda_value
-    value_deserialize(std::byte*& buf, std::size_t& len) {
-        --len;
-        switch (static_cast<typemap>(*(buf++))) {
-            using enum typemap;
-        case LRT_INT16: return deserialize_numeric<std::int16_t>(buf, len);
-        case LRT_INT32: return deserialize_numeric<std::int32_t>(buf, len);
-        case LRT_INT64: return deserialize_numeric<std::int64_t>(buf, len);
-        case LRT_UINT16: return deserialize_numeric<std::uint16_t>(buf, len);
-        case LRT_UINT32: return deserialize_numeric<std::uint32_t>(buf, len);
-        case LRT_UINT64: return deserialize_numeric<std::uint64_t>(buf, len);
-        case LRT_FLOAT: return deserialize_numeric<float>(buf, len);
-        case LRT_DOUBLE: return deserialize_numeric<double>(buf, len);
-        case LRT_STRING: return deserialize_string(buf, len);
-        case LRT_FNCALL: {
-            const auto tuple = tuple_deserialize(buf, len);
-            const auto fn_name = deserialize_string(buf, len);
-            return ldb::lv::fn_call_holder(fn_name, tuple.clone());
+        template<class T>
+        ldb::lv::linda_array<T>
+        read_array() {
+            const auto count = static_cast<std::size_t>(read_varint());
+            const auto bytes = take(count * sizeof(T));
+            return ldb::lv::linda_array<T>::build(count, [src = bytes.data()](std::span<T> elems) {
+                std::memcpy(elems.data(), src, elems.size_bytes());
+                if constexpr (std::integral<T> && sizeof(T) > 1) {
+                    for (auto& elem : elems) elem = swap_unless_comm_endian(elem);
+                }
+            });
         }
-        case LRT_CALLTAG: {
-            return ldb::lv::fn_call_tag{};
+
+        ldb::lv::linda_value
+        read_value() {
+            assert_that(!buf.empty());
+            const auto type = static_cast<typemap>(take(1)[0]);
+            switch (type) {
+                using enum typemap;
+            case LRT_INT16: return read_int<std::int16_t>();
+            case LRT_INT32: return read_int<std::int32_t>();
+            case LRT_INT64: return read_int<std::int64_t>();
+            case LRT_UINT16: return read_int<std::uint16_t>();
+            case LRT_UINT32: return read_int<std::uint32_t>();
+            case LRT_UINT64: return read_int<std::uint64_t>();
+            case LRT_FLOAT: return read_float<float>();
+            case LRT_DOUBLE: return read_float<double>();
+            case LRT_STRING: return ldb::lv::linda_string(read_string_view());
+            case LRT_FNCALL: {
+                const auto tuple = read_tuple();
+                const auto fn_name = std::string(read_string_view());
+                return ldb::lv::fn_call_holder(fn_name, tuple.clone());
+            }
+            case LRT_CALLTAG: {
+                return ldb::lv::fn_call_tag{};
+            }
+            case LRT_SYMBOL: return ldb::lv::linda_symbol(read_string_view());
+            case LRT_BYTES: return read_array<std::byte>();
+            case LRT_INT32_ARRAY: return read_array<std::int32_t>();
+            case LRT_INT64_ARRAY: return read_array<std::int64_t>();
+            case LRT_FLOAT_ARRAY: return read_array<float>();
+            case LRT_DOUBLE_ARRAY: return read_array<double>();
+            }
+            LDB_UNREACHABLE;
         }
+
+        ldb::lv::linda_tuple
+        read_tuple() {
+            const auto tuple_sz = static_cast<std::size_t>(read_varint());
+            std::vector<ldb::lv::linda_value> vals;
+            vals.reserve(tuple_sz);
+            for (std::size_t i = 0; i < tuple_sz; ++i) vals.emplace_back(read_value());
+            return ldb::lv::linda_tuple(std::move(vals));
         }
-        LDB_UNREACHABLE;
-    }
 
-    ldb::lv::linda_tuple
-    tuple_deserialize(std::byte*& buf, std::size_t& len) {
-        using namespace ldb::lv;
-        std::vector<ldb::lv::linda_value> vals;
-        const auto tuple_sz = deserialize_numeric<std::size_t>(buf, len);
-        vals.reserve(tuple_sz);
-        for (std::size_t i = 0; i < tuple_sz; ++i) {
-            auto val = value_deserialize(buf, len);
-            vals.emplace_back(val);
+    private:
+        std::span<const std::byte>
+        take(std::size_t len) {
+            assert_that(buf.size() >= len);
+            const auto taken = buf.first(len);
+            buf = buf.subspan(len);
+            return taken;
         }
-        return ldb::lv::linda_tuple(vals);
-    }
+    };
+}
+
+std::size_t
+lrt::serialize_into(std::vector<std::byte>& buf, const ldb::lv::linda_tuple& tuple) {
+    const auto start = buf.size();
+    buf.push_back(std::byte{1});
+    value_serializator{buf}.write_tuple(tuple);
+    return buf.size() - start;
 }
 
 std::pair<std::unique_ptr<std::byte[]>, std::size_t>
 lrt::serialize(const ldb::lv::linda_tuple& tuple) {
-    return tuple_serialize(tuple);
+    // reused by every call on the thread, so it only grows to the largest tuple once
+    thread_local std::vector<std::byte> scratch;
+    scratch.clear();
+    const auto serial_size = serialize_into(scratch, tuple);
+
+    auto buf = std::make_unique_for_overwrite<std::byte[]>(serial_size);
+    std::memcpy(buf.get(), scratch.data(), serial_size);
+    return std::make_pair(std::move(buf), serial_size);
 }
 
 ldb::lv::linda_tuple
 lrt::deserialize(std::span<std::byte> buf) {
-    auto tuple_sz = buf.size() - 1;
-    auto tuple_payload_start = buf.data() + 1;
-    return tuple_deserialize(tuple_payload_start, tuple_sz);
+    assert_that(!buf.empty());
+    return value_deserializator{buf.subspan(1)}.read_tuple();
 }
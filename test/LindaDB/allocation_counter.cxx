@@ -0,0 +1,127 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/allocation_counter --
+ *   Replacements of the global allocation functions counting the allocations of
+ *   the current thread for allocation_test. They live in their own translation
+ *   unit, so the compiler does not pair the inlined frees with new-expressions.
+ */
+
+#ifndef LINDA_DB_USE_MIMALLOC
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    thread_local std::size_t allocations = 0;
+
+    void*
+    counted_allocate(std::size_t size, std::size_t alignment) noexcept {
+        ++allocations;
+        if (size == 0) size = 1;
+        if (alignment <= alignof(std::max_align_t)) return std::malloc(size);
+        // aligned_alloc wants the size to be a multiple of the alignment
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+
+    void*
+    counted_allocate_or_throw(std::size_t size, std::size_t alignment) {
+        if (auto* ptr = counted_allocate(size, alignment)) return ptr;
+        throw std::bad_alloc();
+    }
+}
+
+std::size_t
+allocation_count() noexcept {
+    return allocations;
+}
+
+void*
+operator new(std::size_t n) {
+    return counted_allocate_or_throw(n, alignof(std::max_align_t));
+}
+void*
+operator new[](std::size_t n) {
+    return counted_allocate_or_throw(n, alignof(std::max_align_t));
+}
+void*
+operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    return counted_allocate(n, alignof(std::max_align_t));
+}
+void*
+operator new[](std::size_t n, const std::nothrow_t&) noexcept {
+    return counted_allocate(n, alignof(std::max_align_t));
+}
+void*
+operator new(std::size_t n, std::align_val_t al) {
+    return counted_allocate_or_throw(n, static_cast<std::size_t>(al));
+}
+void*
+operator new[](std::size_t n, std::align_val_t al) {
+    return counted_allocate_or_throw(n, static_cast<std::size_t>(al));
+}
+void*
+operator new(std::size_t n, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return counted_allocate(n, static_cast<std::size_t>(al));
+}
+void*
+operator new[](std::size_t n, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return counted_allocate(n, static_cast<std::size_t>(al));
+}
+
+void
+operator delete(void* p) noexcept { std::free(p); }
+void
+operator delete[](void* p) noexcept { std::free(p); }
+void
+operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void
+operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void
+operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void
+operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void
+operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void
+operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void
+operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void
+operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void
+operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void
+operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+#endif
@@ -0,0 +1,100 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/allocation_test --
+ *   Tests that the queries of a store operation are built without heap
+ *   allocations. Counting needs the global allocation functions replaced (see
+ *   allocation_counter.cxx), so this is a separate executable, and is only
+ *   built when mimalloc does not already replace them.
+ */
+
+#ifndef LINDA_DB_USE_MIMALLOC
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+#include <ldb/lv/linda_tuple.hxx>
+#include <ldb/query/manual_fields_query.hxx>
+#include <ldb/query/match_type.hxx>
+#include <ldb/query/tuple_query.hxx>
+#include <ldb/store.hxx>
+
+std::size_t
+allocation_count() noexcept;
+
+namespace {
+    template<class Fn>
+    std::size_t
+    count_allocations(Fn&& fn) {
+        const auto before = allocation_count();
+        std::forward<Fn>(fn)();
+        return allocation_count() - before;
+    }
+}
+
+using index_type = ldb::index::tree::avl2_tree<ldb::lv::linda_value, ldb::store::pointer_type>;
+using query_type = ldb::store::query_type;
+
+TEST_CASE("count_allocations sees heap allocations") {
+    std::unique_ptr<int> kept;
+    CHECK(count_allocations([&kept] { kept = std::make_unique<int>(1); }) == 1);
+}
+
+TEST_CASE("tuple_query of a small query does not allocate") {
+    int i{};
+    CHECK(count_allocations([&i] {
+              query_type query = ldb::make_query(ldb::over_index<index_type>, 1, 2L, ldb::ref(&i));
+              auto copy = query;
+              auto moved = std::move(copy);
+              query = moved;
+          })
+          == 0);
+}
+
+TEST_CASE("store rd and in do not allocate") {
+    ldb::store store;
+    store.out(ldb::lv::linda_tuple(1, 2L, 3));
+    store.out(ldb::lv::linda_tuple(1, 2L, 3));
+
+    int i{};
+    CHECK(count_allocations([&] { std::ignore = store.rd(1, 2L, ldb::ref(&i)); }) == 0);
+    CHECK(count_allocations([&] { std::ignore = store.rdp(1, 2L, ldb::ref(&i)); }) == 0);
+    CHECK(count_allocations([&] { std::ignore = store.inp(1, 2L, ldb::ref(&i)); }) == 0);
+    CHECK(count_allocations([&] { std::ignore = store.in(1, 2L, ldb::ref(&i)); }) == 0);
+    CHECK(i == 3);
+}
+
+
+#endif
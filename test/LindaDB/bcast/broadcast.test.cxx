@@ -76,37 +76,37 @@ TEST_CASE("awaitable handles self-assigment") {
 
 TEST_CASE("broadcaster can broadcast insert") {
     const ldb::broadcast bcast = ldb::null_broadcast{};
-    await(broadcast_insert(bcast, ldb::lv::linda_tuple{}));
+    await(broadcast_insert(bcast, ldb::data::tuple_id{}, ldb::lv::linda_tuple{}));
 }
 
 TEST_CASE("broadcaster can broadcast delete") {
     const ldb::broadcast bcast = ldb::null_broadcast{};
-    await(broadcast_delete(bcast, ldb::lv::linda_tuple{}));
+    await(broadcast_delete(bcast, ldb::data::tuple_id{}));
 }
 
 TEST_CASE("default constructed broadcaster can be called, is nop") {
     const ldb::broadcast bcast;
-    broadcast_insert(bcast, ldb::lv::linda_tuple{});
-    broadcast_delete(bcast, ldb::lv::linda_tuple{});
+    broadcast_insert(bcast, ldb::data::tuple_id{}, ldb::lv::linda_tuple{});
+    broadcast_delete(bcast, ldb::data::tuple_id{});
 }
 
 TEST_CASE("broadcast can be move constructed") {
     ldb::broadcast bcast = ldb::null_broadcast{};
     const ldb::broadcast bcast2 = std::move(bcast);
-    await(broadcast_insert(bcast2, ldb::lv::linda_tuple{}));
+    await(broadcast_insert(bcast2, ldb::data::tuple_id{}, ldb::lv::linda_tuple{}));
 }
 
 TEST_CASE("broadcast can be move assigned") {
     ldb::broadcast bcast = ldb::null_broadcast{};
     ldb::broadcast bcast2;
     bcast2 = std::move(bcast);
-    await(broadcast_insert(bcast2, ldb::lv::linda_tuple{}));
+    await(broadcast_insert(bcast2, ldb::data::tuple_id{}, ldb::lv::linda_tuple{}));
 }
 
 TEST_CASE("broadcast handles self-assignment") {
     ldb::broadcast bcast = ldb::null_broadcast{};
     bcast = std::move(bcast);
-    await(broadcast_insert(bcast, ldb::lv::linda_tuple{}));
+    await(broadcast_insert(bcast, ldb::data::tuple_id{}, ldb::lv::linda_tuple{}));
 }
 
 #pragma clang diagnostic pop
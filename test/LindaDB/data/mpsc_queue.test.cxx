@@ -0,0 +1,88 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/data/mpsc_queue --
+ *   Tests for the multi-producer single-consumer queue.
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <ldb/data/mpsc_queue.hxx>
+
+namespace ld = ldb::data;
+
+TEST_CASE("mpsc_queue pops values in the order they were pushed") {
+    ld::mpsc_queue<std::string> sut;
+    CHECK_FALSE(sut.try_pop().has_value());
+    sut.push("a");
+    sut.push("b");
+    CHECK(sut.try_pop() == "a");
+    sut.push("c");
+    CHECK(sut.try_pop() == "b");
+    CHECK(sut.try_pop() == "c");
+    CHECK_FALSE(sut.try_pop().has_value());
+}
+
+TEST_CASE("mpsc_queue frees values left in it") {
+    ld::mpsc_queue<std::string> sut;
+    sut.push(std::string(100, 'a'));
+    sut.push(std::string(100, 'b'));
+    CHECK(sut.try_pop() == std::string(100, 'a'));
+}
+
+TEST_CASE("mpsc_queue keeps the order of each producer") {
+    constexpr const int producers = 4;
+    constexpr const int count = 20'000;
+    ld::mpsc_queue<std::pair<int, int>> sut;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&sut, p] {
+            for (int i = 0; i < count; ++i) sut.push({p, i});
+        });
+    }
+
+    std::vector<int> next(producers, 0);
+    auto in_order = true;
+    for (int popped = 0; popped < producers * count;) {
+        const auto value = sut.try_pop();
+        if (!value) continue;
+        const auto [p, i] = *value;
+        if (next[static_cast<std::size_t>(p)]++ != i) in_order = false;
+        ++popped;
+    }
+    for (auto& thread : threads) thread.join();
+    CHECK(in_order);
+    CHECK_FALSE(sut.try_pop().has_value());
+}
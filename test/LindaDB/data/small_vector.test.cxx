@@ -0,0 +1,178 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/data/small_vector --
+ *   Tests for the small_vector container.
+ */
+
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+#include <ldb/data/small_vector.hxx>
+
+namespace ld = ldb::data;
+using sut_type = ld::small_vector<std::string, 2>;
+
+TEST_CASE("small_vector default constructs empty and inline") {
+    const sut_type sut;
+    CHECK(sut.empty());
+    CHECK(sut.is_inline());
+    CHECK(sut.capacity() == 2);
+}
+
+TEST_CASE("small_vector stays inline up to its inline capacity") {
+    sut_type sut;
+    sut.push_back("a");
+    sut.push_back("b");
+    CHECK(sut.is_inline());
+    CHECK(sut.size() == 2);
+    CHECK(sut[0] == "a");
+    CHECK(sut[1] == "b");
+}
+
+TEST_CASE("small_vector spills to the heap over its inline capacity") {
+    sut_type sut{"a", "b", "c"};
+    CHECK_FALSE(sut.is_inline());
+    CHECK(sut.size() == 3);
+    CHECK(sut == sut_type{"a", "b", "c"});
+}
+
+TEST_CASE("small_vector can push its own element while growing") {
+    sut_type sut{"a", "b"};
+    sut.push_back(sut[0]);
+    CHECK(sut == sut_type{"a", "b", "a"});
+}
+
+TEST_CASE("small_vector erases elements in order") {
+    sut_type sut{"a", "b", "c", "d"};
+    auto it = sut.erase(std::next(sut.begin()));
+    CHECK(*it == "c");
+    CHECK(sut == sut_type{"a", "c", "d"});
+    sut.erase(std::prev(sut.end()));
+    CHECK(sut == sut_type{"a", "c"});
+}
+
+TEST_CASE("small_vector pops its last element") {
+    sut_type sut{"a", "b", "c"};
+    CHECK(sut.back() == "c");
+    sut.pop_back();
+    CHECK(sut.back() == "b");
+    CHECK(sut == sut_type{"a", "b"});
+}
+
+TEST_CASE("small_vector copies") {
+    SECTION("inline") {
+        const sut_type sut{"a"};
+        const sut_type cp = sut; // NOLINT(*-unnecessary-copy-initialization)
+        CHECK(cp == sut);
+    }
+    SECTION("spilled") {
+        const sut_type sut{"a", "b", "c"};
+        sut_type cp{"x"};
+        cp = sut;
+        CHECK(cp == sut);
+    }
+}
+
+TEST_CASE("small_vector moves") {
+    SECTION("inline") {
+        sut_type sut{"a"};
+        const sut_type mv = std::move(sut);
+        CHECK(mv == sut_type{"a"});
+        CHECK(sut.empty()); // NOLINT(*-use-after-move)
+    }
+    SECTION("spilled steals the heap buffer") {
+        sut_type sut{"a", "b", "c"};
+        const auto* buffer = sut.data();
+        sut_type mv{"x"};
+        mv = std::move(sut);
+        CHECK(mv.data() == buffer);
+        CHECK(mv == sut_type{"a", "b", "c"});
+        CHECK(sut.empty()); // NOLINT(*-use-after-move)
+        CHECK(sut.is_inline());
+    }
+}
+
+TEST_CASE("small_vector destroys its elements") {
+    auto counter = std::make_shared<int>(0);
+    {
+        ld::small_vector<std::shared_ptr<int>, 1> sut;
+        sut.push_back(counter);
+        sut.push_back(counter);
+        CHECK(counter.use_count() == 3);
+        sut.clear();
+        CHECK(counter.use_count() == 1);
+        sut.push_back(counter);
+    }
+    CHECK(counter.use_count() == 1);
+}
+
+namespace {
+    struct throwing_copy {
+        explicit throwing_copy(int v, std::shared_ptr<int> counter)
+             : value(v), live(std::move(counter)) { }
+
+        throwing_copy(const throwing_copy& other)
+             : value(other.value), live(other.live) {
+            if (value < 0) throw std::runtime_error("copy");
+        }
+
+        // NOLINTNEXTLINE(*-noexcept-move*) a throwing move makes growing copy
+        throwing_copy(throwing_copy&& other) : value(other.value), live(other.live) { }
+
+        throwing_copy& operator=(const throwing_copy&) = default;
+        throwing_copy& operator=(throwing_copy&&) = default;
+        ~throwing_copy() = default;
+
+        int value;
+        std::shared_ptr<int> live;
+    };
+}
+
+TEST_CASE("small_vector keeps its elements if growing throws") {
+    auto counter = std::make_shared<int>(0);
+    ld::small_vector<throwing_copy, 2> sut;
+    sut.emplace_back(1, counter);
+    sut.emplace_back(-1, counter);
+    CHECK_THROWS_AS(sut.emplace_back(2, counter), std::runtime_error);
+    CHECK(sut.size() == 2);
+    CHECK(sut.is_inline());
+    CHECK(sut[0].value == 1);
+    CHECK(sut[1].value == -1);
+    CHECK(counter.use_count() == 3);
+    sut.clear();
+    CHECK(counter.use_count() == 1);
+}
@@ -0,0 +1,85 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/data/spsc_queue --
+ *   Tests for the single-producer single-consumer queue.
+ */
+
+#include <string>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+#include <ldb/data/spsc_queue.hxx>
+
+namespace ld = ldb::data;
+
+TEST_CASE("spsc_queue rounds its capacity up to a power of two") {
+    CHECK(ld::spsc_queue<int>(5).capacity() == 8);
+    CHECK(ld::spsc_queue<int>(8).capacity() == 8);
+    CHECK(ld::spsc_queue<int>(0).capacity() == 1);
+}
+
+TEST_CASE("spsc_queue pops values in the order they were pushed") {
+    ld::spsc_queue<std::string> sut(4);
+    CHECK_FALSE(sut.try_pop().has_value());
+    CHECK(sut.try_push("a"));
+    CHECK(sut.try_push("b"));
+    CHECK(sut.try_pop() == "a");
+    CHECK(sut.try_push("c"));
+    CHECK(sut.try_pop() == "b");
+    CHECK(sut.try_pop() == "c");
+    CHECK_FALSE(sut.try_pop().has_value());
+}
+
+TEST_CASE("spsc_queue refuses to push over its capacity") {
+    ld::spsc_queue<int> sut(2);
+    CHECK(sut.try_push(1));
+    CHECK(sut.try_push(2));
+    CHECK_FALSE(sut.try_push(3));
+    CHECK(sut.try_pop() == 1);
+    CHECK(sut.try_push(3));
+}
+
+TEST_CASE("spsc_queue hands every value across threads in order") {
+    constexpr const int count = 100'000;
+    ld::spsc_queue<int> sut(16);
+    std::thread producer([&sut] {
+        for (int i = 0; i < count; ++i) sut.push(i);
+    });
+
+    auto in_order = true;
+    for (int i = 0; i < count; ++i) {
+        if (sut.pop() != i) in_order = false;
+    }
+    producer.join();
+    CHECK(in_order);
+}
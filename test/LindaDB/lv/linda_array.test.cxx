@@ -0,0 +1,159 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/lv/linda_array --
+ *   Tests for the binary blob and numeric array types of linda_values.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <ldb/lv/linda_array.hxx>
+#include <ldb/lv/linda_tuple.hxx>
+#include <ldb/store.hxx>
+
+namespace lv = ldb::lv;
+
+TEST_CASE("linda_array is pointer sized") {
+    STATIC_CHECK(sizeof(lv::linda_array<double>) == sizeof(void*));
+    STATIC_CHECK(sizeof(lv::linda_bytes) == sizeof(void*));
+}
+
+TEMPLATE_TEST_CASE("linda_array holds a copy of its elements",
+                   "[linda_array]",
+                   std::int32_t,
+                   std::int64_t,
+                   float,
+                   double) {
+    std::vector<TestType> source(100);
+    std::iota(source.begin(), source.end(), TestType{});
+    const lv::linda_array<TestType> sut(source);
+    source[0] = TestType{7};
+
+    REQUIRE(sut.size() == 100);
+    CHECK(sut[0] == TestType{});
+    CHECK(sut[99] == TestType{99});
+    CHECK(static_cast<std::vector<TestType>>(sut).size() == 100);
+}
+
+TEST_CASE("linda_array elements are cache-line aligned") {
+    const lv::linda_array<double> sut{1.0, 2.0, 3.0};
+    CHECK(reinterpret_cast<std::uintptr_t>(sut.data()) % 64 == 0);
+}
+
+TEST_CASE("linda_array copies share their elements") {
+    const lv::linda_array<double> sut{1.0, 2.0, 3.0};
+    const auto copy = sut; // NOLINT(*-unnecessary-copy-initialization)
+    CHECK(copy.data() == sut.data());
+    CHECK(copy == sut);
+}
+
+TEST_CASE("linda_array slices share their elements") {
+    const lv::linda_array<std::int32_t> sut{0, 1, 2, 3, 4, 5};
+    const auto slice = sut.slice(2, 3);
+    CHECK(slice.data() == sut.data() + 2);
+    CHECK(slice == lv::linda_array<std::int32_t>{2, 3, 4});
+
+    const auto slice_of_slice = slice.slice(1, 1);
+    CHECK(slice_of_slice.data() == sut.data() + 3);
+    CHECK(slice_of_slice == lv::linda_array<std::int32_t>{3});
+}
+
+TEST_CASE("linda_array slice outlives its source") {
+    lv::linda_array<std::int64_t> slice;
+    {
+        const lv::linda_array<std::int64_t> sut{10, 11, 12};
+        slice = sut.slice(1, 2);
+    }
+    CHECK(slice == lv::linda_array<std::int64_t>{11, 12});
+}
+
+TEST_CASE("empty linda_arrays are equal") {
+    CHECK(lv::linda_array<float>() == lv::linda_array<float>(std::vector<float>{}));
+    CHECK(lv::linda_array<float>{1.0F}.slice(0, 0) == lv::linda_array<float>());
+}
+
+TEST_CASE("linda_array builds its elements in place") {
+    const auto sut = lv::linda_bytes::build(4, [](std::span<std::byte> bytes) {
+        for (std::size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<std::byte>(i);
+    });
+    CHECK(sut == lv::linda_bytes{std::byte{0}, std::byte{1}, std::byte{2}, std::byte{3}});
+}
+
+TEST_CASE("linda_array orders lexicographically") {
+    using arr = lv::linda_array<std::int32_t>;
+    CHECK(arr{1, 2} < arr{1, 3});
+    CHECK(arr{1, 2} < arr{1, 2, 0});
+    CHECK(arr{2} > arr{1, 9});
+    CHECK((arr{1, 2} <=> arr{1, 2}) == std::strong_ordering::equal);
+}
+
+TEST_CASE("linda_array of floats compares bitwise") {
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    CHECK(lv::linda_array<double>{nan} == lv::linda_array<double>{nan});
+    CHECK(lv::linda_array<double>{0.0} != lv::linda_array<double>{-0.0});
+    CHECK(lv::linda_array<double>{-0.0} < lv::linda_array<double>{0.0});
+}
+
+TEST_CASE("equal linda_arrays hash equal") {
+    const lv::linda_array<double> lhs{1.0, 2.0};
+    const lv::linda_array<double> rhs{1.0, 2.0};
+    CHECK(std::hash<lv::linda_array<double>>{}(lhs) == std::hash<lv::linda_array<double>>{}(rhs));
+}
+
+TEST_CASE("linda_array prints its leading elements") {
+    std::ostringstream ss;
+    ss << lv::linda_array<std::int32_t>{1, 2, 3};
+    CHECK(ss.str() == "[1, 2, 3]");
+}
+
+TEST_CASE("store matches numeric arrays by type") {
+    ldb::store store;
+    const lv::linda_array<double> data{1.0, 2.0, 3.0};
+    store.out(lv::linda_tuple("data", data));
+
+    lv::linda_array<double> shared;
+    CHECK(store.rdp("data", ldb::ref(&shared)) == lv::linda_tuple("data", data));
+    CHECK(shared.data() == data.data());
+
+    std::vector<double> copied;
+    CHECK(store.inp("data", ldb::ref(&copied)) == lv::linda_tuple("data", data));
+    CHECK(copied == std::vector<double>{1.0, 2.0, 3.0});
+}
@@ -0,0 +1,120 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/lv/linda_string --
+ *   Tests for the compact string type of linda_values.
+ */
+
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+#include <ldb/lv/linda_string.hxx>
+
+namespace lv = ldb::lv;
+using namespace std::literals;
+
+TEST_CASE("linda_string is pointer sized") {
+    STATIC_CHECK(sizeof(lv::linda_string) == sizeof(void*));
+}
+
+TEST_CASE("linda_string default constructs empty") {
+    const lv::linda_string sut;
+    CHECK(sut.empty());
+    CHECK(sut.is_inline());
+    CHECK(std::strlen(sut.c_str()) == 0);
+}
+
+TEST_CASE("linda_string stores short strings inline") {
+    const std::string str(lv::linda_string::inline_capacity, 'x');
+    const lv::linda_string sut(str);
+    CHECK(sut.is_inline());
+    CHECK(sut.view() == str);
+    CHECK(sut.c_str()[str.size()] == '\0');
+}
+
+TEST_CASE("linda_string stores long strings on the heap") {
+    const std::string str(lv::linda_string::inline_capacity + 1, 'x');
+    const lv::linda_string sut(str);
+    CHECK_FALSE(sut.is_inline());
+    CHECK(sut.view() == str);
+    CHECK(sut.c_str()[str.size()] == '\0');
+}
+
+TEST_CASE("linda_string copies share long strings") {
+    const lv::linda_string sut("a string too long to be inline");
+    const lv::linda_string cp = sut; // NOLINT(*-unnecessary-copy-initialization)
+    CHECK(cp.data() == sut.data());
+    CHECK(cp == sut);
+}
+
+TEST_CASE("linda_string moves leave an empty string behind") {
+    lv::linda_string sut("a string too long to be inline");
+    const lv::linda_string mv = std::move(sut);
+    CHECK(mv == "a string too long to be inline"sv);
+    CHECK(sut.empty()); // NOLINT(*-use-after-move)
+    CHECK(std::strlen(sut.c_str()) == 0);
+}
+
+TEST_CASE("linda_string assigns") {
+    lv::linda_string sut("short");
+    const lv::linda_string long_str("a string too long to be inline");
+    sut = long_str;
+    CHECK(sut == long_str);
+    sut = lv::linda_string("tiny");
+    CHECK(sut == "tiny"sv);
+}
+
+TEST_CASE("linda_string compares as its contents") {
+    const lv::linda_string inline_str("abc");
+    const lv::linda_string heap_str("abcdefghijklmnopqrstuvwxyz");
+    CHECK(inline_str < heap_str);
+    CHECK(heap_str > inline_str);
+    CHECK(inline_str == "abc"sv);
+    CHECK("abc"s == inline_str);
+    CHECK(heap_str == lv::linda_string("abcdefghijklmnopqrstuvwxyz"));
+}
+
+TEST_CASE("linda_string hashes as its contents") {
+    const lv::linda_string sut("abcdefghijklmnopqrstuvwxyz");
+    CHECK(std::hash<lv::linda_string>{}(sut) == std::hash<std::string_view>{}("abcdefghijklmnopqrstuvwxyz"sv));
+}
+
+TEST_CASE("linda_string prints its contents") {
+    std::ostringstream ss;
+    ss << lv::linda_string("hello") << " " << lv::linda_string("a string too long to be inline");
+    CHECK(ss.str() == "hello a string too long to be inline");
+}
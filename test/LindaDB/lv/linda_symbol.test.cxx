@@ -0,0 +1,113 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/lv/linda_symbol --
+ *   Tests for the interned symbol type of linda_values.
+ */
+
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <ldb/lv/linda_symbol.hxx>
+
+namespace lv = ldb::lv;
+using namespace std::literals;
+using namespace lv::literals;
+
+TEST_CASE("linda_symbol is pointer sized") {
+    STATIC_CHECK(sizeof(lv::linda_symbol) == sizeof(void*));
+}
+
+TEST_CASE("linda_symbol default constructs empty") {
+    const lv::linda_symbol sut;
+    CHECK(sut.empty());
+    CHECK(sut.view().empty());
+    CHECK(sut == lv::linda_symbol(""));
+}
+
+TEST_CASE("linda_symbol interns equal texts to the same entry") {
+    const std::string text = "result";
+    const lv::linda_symbol lhs(text);
+    const lv::linda_symbol rhs("result"sv);
+    CHECK(lhs == rhs);
+    CHECK(lhs == "result"_sym);
+    CHECK(lv::linda_symbol::intern(text) == lv::linda_symbol::intern("result"));
+    CHECK(lhs.view() == "result");
+    CHECK(lhs.view().data() == rhs.view().data());
+}
+
+TEST_CASE("linda_symbol distinguishes different texts") {
+    CHECK("task"_sym != "tasks"_sym);
+    CHECK("task"_sym != lv::linda_symbol{});
+}
+
+TEST_CASE("linda_symbol orders by text") {
+    CHECK("a"_sym < "b"_sym);
+    CHECK("ab"_sym > "a"_sym);
+    CHECK(lv::linda_symbol{} < "a"_sym);
+    CHECK(("x"_sym <=> "x"_sym) == std::strong_ordering::equal);
+}
+
+TEST_CASE("linda_symbol hashes like its text") {
+    CHECK(std::hash<lv::linda_symbol>{}("task"_sym) == std::hash<std::string_view>{}("task"));
+    CHECK(std::hash<lv::linda_symbol>{}({}) == std::hash<std::string_view>{}(""));
+}
+
+TEST_CASE("linda_symbol prints its text") {
+    std::ostringstream ss;
+    ss << "task"_sym;
+    CHECK(ss.str() == "task");
+}
+
+TEST_CASE("linda_symbol interning is thread safe") {
+    constexpr const auto thread_count = 4;
+    constexpr const auto symbol_count = 200;
+    std::vector<std::vector<const lv::linda_symbol::entry*>> seen(thread_count);
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&entries = seen[t]] {
+                for (int i = 0; i < symbol_count; ++i) {
+                    entries.push_back(lv::linda_symbol::intern("sym-" + std::to_string(i)));
+                }
+            });
+        }
+    }
+    for (int t = 1; t < thread_count; ++t) {
+        CHECK(seen[t] == seen[0]);
+    }
+}
@@ -34,7 +34,11 @@
  *   Tests for the lv::linda_tuple type.
  */
 
+#include <functional>
 #include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -190,6 +194,108 @@ TEST_CASE("linda_tuple can be instantiated from a span of vals") {
     }
 }
 
+TEST_CASE("linda_tuple can take the values of a vector") {
+    auto vals = std::vector<lv::linda_value>{3, "a long string value", 5.0, 6ULL, 7};
+    auto expected = lv::linda_tuple(3, "a long string value", 5.0, 6ULL, 7);
+    auto sut = lv::linda_tuple(std::move(vals));
+    CHECK(sut == expected);
+}
+
+TEST_CASE("linda_tuple is two words regardless of its size") {
+    STATIC_CHECK(sizeof(lv::linda_tuple) == 2 * sizeof(void*));
+    STATIC_CHECK(std::is_nothrow_move_constructible_v<lv::linda_tuple>);
+    STATIC_CHECK(std::is_nothrow_move_assignable_v<lv::linda_tuple>);
+}
+
+TEST_CASE("linda_tuple copies are independent") {
+    lv::linda_tuple original(1, "two", 3.0, 4, 5);
+    lv::linda_tuple copy(original);
+    CHECK(copy == original);
+
+    copy[1] = lv::linda_value(2);
+    CHECK(copy != original);
+    CHECK(original[1] == lv::linda_value("two"));
+
+    copy = original;
+    CHECK(copy == original);
+}
+
+TEST_CASE("linda_tuple copies share their values") {
+    const lv::linda_tuple original(1, "two", 3.0);
+    const lv::linda_tuple copy = original; // NOLINT(*-unnecessary-copy-initialization)
+    CHECK(&copy[0] == &original[0]);
+}
+
+TEST_CASE("writing a linda_tuple copy unshares it") {
+    lv::linda_tuple original(1, "two", 3.0);
+    lv::linda_tuple copy = original;
+    const auto* shared = &std::as_const(original)[0];
+
+    copy[0] = lv::linda_value(42);
+    CHECK(&std::as_const(copy)[0] != shared);
+    CHECK(&std::as_const(original)[0] == shared);
+    CHECK(original == lv::linda_tuple(1, "two", 3.0));
+    CHECK(copy == lv::linda_tuple(42, "two", 3.0));
+}
+
+TEST_CASE("linda_tuple copied after mutable access does not see later writes") {
+    lv::linda_tuple original(1, 2);
+    auto& field = original[0];
+    const lv::linda_tuple copy = original;
+
+    field = lv::linda_value(3);
+    CHECK(original == lv::linda_tuple(3, 2));
+    CHECK(copy == lv::linda_tuple(1, 2));
+}
+
+TEST_CASE("moved-from linda_tuple is empty") {
+    lv::linda_tuple original(1, "two", 3.0);
+    const lv::linda_tuple expected = original;
+
+    lv::linda_tuple moved(std::move(original));
+    CHECK(moved == expected);
+    CHECK(original.size() == 0); // NOLINT(*-use-after-move)
+
+    original = std::move(moved);
+    CHECK(original == expected);
+    CHECK(moved == lv::linda_tuple()); // NOLINT(*-use-after-move)
+}
+
+TEST_CASE("linda_tuple hash depends on field order") {
+    CHECK(lv::linda_tuple("a", 1, 2).hash() != lv::linda_tuple("a", 2, 1).hash());
+    CHECK(lv::linda_tuple("a", 1, 1).hash() != lv::linda_tuple("a", 2, 2).hash());
+    CHECK(lv::linda_tuple(1, 2).hash() != lv::linda_tuple(1, 2, 0).hash());
+}
+
+TEST_CASE("equal linda_tuples hash equal") {
+    const lv::linda_tuple lhs("task", 1, 2.0);
+    const lv::linda_tuple rhs("task", 1, 2.0);
+    CHECK(lhs.hash() == rhs.hash());
+    CHECK(std::hash<lv::linda_tuple>{}(lhs) == std::hash<lv::linda_tuple>{}(rhs));
+
+    const lv::linda_tuple copy = lhs;
+    CHECK(copy.hash() == lhs.hash());
+}
+
+TEST_CASE("writing a linda_tuple field updates its hash and signature") {
+    lv::linda_tuple sut("task", 1);
+    const auto old_hash = sut.hash();
+    const auto old_signature = sut.signature();
+
+    sut[1] = lv::linda_value(2.0);
+    CHECK(sut.hash() != old_hash);
+    CHECK(sut.signature() != old_signature);
+    CHECK(sut.hash() == lv::linda_tuple("task", 2.0).hash());
+}
+
+TEST_CASE("linda_tuple signature encodes arity and field types") {
+    CHECK(lv::linda_tuple(1, "a").signature() == lv::linda_tuple(2, "b").signature());
+    CHECK(lv::linda_tuple(1, "a").signature() != lv::linda_tuple("a", 1).signature());
+    CHECK(lv::linda_tuple(1, 2).signature() != lv::linda_tuple(1, 2, 3).signature());
+    CHECK(lv::linda_tuple(1).signature() != lv::linda_tuple(1L).signature());
+    CHECK(lv::linda_tuple().signature() == lv::tuple_signature::of_arity(0));
+}
+
 TEST_CASE("linda_tuples can be indexed-into") {
     lv::linda_tuple t3(3, "4", 5.0);
     lv::linda_tuple t4(3, "4", 5.0, 6ULL);
@@ -35,7 +35,9 @@
  */
 
 #include <cstdint>
+#include <functional>
 #include <sstream>
+#include <string>
 
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -112,3 +114,18 @@ TEST_CASE("make_linda_value constructs string value",
         CHECK(lv::linda_value(string_value) == lv::make_linda_value(string_view_value));
     }
 }
+
+TEST_CASE("linda_value is two pointers wide",
+          "[linda_value]") {
+    STATIC_CHECK(sizeof(lv::linda_value) <= 2 * sizeof(void*));
+}
+
+TEST_CASE("linda_value orders strings by their contents",
+          "[linda_value]") {
+    const lv::linda_value short_str("abc");
+    const lv::linda_value long_str("abcdefghijklmnopqrstuvwxyz");
+    CHECK(short_str < long_str);
+    CHECK(long_str == lv::make_linda_value("abcdefghijklmnopqrstuvwxyz"));
+    CHECK(std::hash<lv::linda_value>{}(long_str)
+          == std::hash<lv::linda_value>{}(lv::make_linda_value(std::string("abcdefghijklmnopqrstuvwxyz"))));
+}
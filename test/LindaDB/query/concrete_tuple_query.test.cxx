@@ -158,3 +158,9 @@ TEST_CASE("concrete_tuple_query right-compares as less to member-wise greater tu
 
     CHECK(&cmp_tuple > query);
 }
+
+TEST_CASE("concrete_tuple_query has the signature of its tuple") {
+    ldb::lv::linda_tuple tuple(1, "a", 2.0);
+    ldb::concrete_tuple_query<index_type> query(tuple);
+    CHECK(query.signature() == tuple.signature());
+}
@@ -0,0 +1,115 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/query/manual_fields_query --
+ *   Tests for matching tuples with queries built from matchers.
+ */
+
+#include <optional>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <ldb/index/tree/impl/avl2/avl2_tree.hxx>
+#include <ldb/index/tree/index_query.hxx>
+#include <ldb/lv/linda_tuple.hxx>
+#include <ldb/query/match_value.hxx>
+#include <ldb/query/manual_fields_query.hxx>
+#include <ldb/query/match_type.hxx>
+#include <ldb/store.hxx>
+
+namespace lv = ldb::lv;
+using index_type = ldb::index::tree::avl2_tree<lv::linda_value, ldb::store::pointer_type>;
+
+TEST_CASE("manual_fields_query matches a tuple of equal values") {
+    const auto query = ldb::make_query(ldb::over_index<index_type>, 1, "a long string, not stored inline", 2.5);
+    CHECK(query.matches(lv::linda_tuple(1, "a long string, not stored inline", 2.5)));
+    CHECK(lv::linda_tuple(1, "a long string, not stored inline", 2.5) == query);
+}
+
+TEST_CASE("manual_fields_query rejects tuples of other arity, types or values") {
+    const auto query = ldb::make_query(ldb::over_index<index_type>, 1, "str");
+    CHECK_FALSE(query.matches(lv::linda_tuple(1)));
+    CHECK_FALSE(query.matches(lv::linda_tuple(1, "str", 2)));
+    CHECK_FALSE(query.matches(lv::linda_tuple(1L, "str")));
+    CHECK_FALSE(query.matches(lv::linda_tuple(2, "str")));
+    CHECK_FALSE(query.matches(lv::linda_tuple(1, "stf")));
+}
+
+TEST_CASE("manual_fields_query binds formals of a matching tuple") {
+    int i{};
+    std::string str;
+    const auto query = ldb::make_query(ldb::over_index<index_type>, ldb::ref(&i), "key", ldb::ref(&str));
+    REQUIRE(query.matches(lv::linda_tuple(42, "key", "value")));
+    CHECK(i == 42);
+    CHECK(str == "value");
+}
+
+TEST_CASE("manual_fields_query does not bind formals of a partial match") {
+    int i = -1;
+    const auto query = ldb::make_query(ldb::over_index<index_type>, ldb::ref(&i), "key");
+    CHECK_FALSE(query.matches(lv::linda_tuple(42, "other")));
+    CHECK(i == -1);
+}
+
+TEST_CASE("manual_fields_query orders values of floating types") {
+    const auto query = ldb::make_query(ldb::over_index<index_type>, 2.5);
+    CHECK(std::is_lt(lv::linda_tuple(1.5) <=> query));
+    CHECK(std::is_eq(lv::linda_tuple(2.5) <=> query));
+    CHECK(std::is_neq(lv::linda_tuple(2.5f) <=> query));
+}
+
+TEST_CASE("manual_fields_query orders values of integral types") {
+    const auto query = ldb::make_query(ldb::over_index<index_type>, 5);
+    CHECK(std::is_lt(lv::linda_tuple(3) <=> query));
+    CHECK(std::is_eq(lv::linda_tuple(5) <=> query));
+    CHECK(std::is_gt(lv::linda_tuple(7) <=> query));
+}
+
+TEST_CASE("match_value finds its values in an index") {
+    ldb::index::tree::avl2_tree<lv::linda_value, int> index;
+    for (int i = 0; i < 64; ++i) index.insert(lv::linda_value(i), i);
+    for (int i = 0; i < 64; ++i) {
+        CHECK(index.search(ldb::index::tree::value_lookup(ldb::match_value<int>(i), i)) == std::optional{i});
+    }
+    CHECK(index.search(ldb::index::tree::value_lookup(ldb::match_value<int>(64), 64)) == std::nullopt);
+}
+
+TEST_CASE("store retrieves tuples by floating point values") {
+    ldb::store store;
+    store.out(lv::linda_tuple("pi", 3.25));
+    store.out(lv::linda_tuple(1.5, "e"));
+    std::string str;
+    CHECK(store.rdp("pi", 3.25));
+    CHECK_FALSE(store.rdp("pi", 3.5));
+    CHECK(store.inp(1.5, ldb::ref(&str)));
+    CHECK(str == "e");
+}
@@ -0,0 +1,80 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/query/template_tuple_query --
+ *   Tests for matching tuples with templates of values and formal fields.
+ */
+
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <ldb/lv/linda_tuple.hxx>
+#include <ldb/query/template_tuple_query.hxx>
+#include <ldb/store.hxx>
+
+namespace lv = ldb::lv;
+using index_type = ldb::index::tree::avl2_tree<lv::linda_value, ldb::store::pointer_type>;
+
+TEST_CASE("template_tuple_query without formals matches only an equal tuple") {
+    const ldb::template_tuple_query<index_type> query(lv::linda_tuple("key", 1, 2.5), 0);
+    CHECK(lv::linda_tuple("key", 1, 2.5) == query);
+    CHECK_FALSE(lv::linda_tuple("key", 2, 2.5) == query);
+    CHECK_FALSE(lv::linda_tuple("key", 1) == query);
+}
+
+TEST_CASE("template_tuple_query formal fields match any value of their type") {
+    const ldb::template_tuple_query<index_type> query(lv::linda_tuple("key", 0, std::string()), 0b110);
+    CHECK(lv::linda_tuple("key", 1, "one") == query);
+    CHECK(lv::linda_tuple("key", 42, "") == query);
+    CHECK_FALSE(lv::linda_tuple("key", 1L, "one") == query);
+    CHECK_FALSE(lv::linda_tuple("other", 1, "one") == query);
+}
+
+TEST_CASE("template_tuple_query cannot search via a formal field") {
+    const ldb::template_tuple_query<index_type> query(lv::linda_tuple(0, "value"), 0b1);
+    index_type index;
+    CHECK(std::holds_alternative<ldb::field_incomparable>(query.search_via_field(0, index)));
+    CHECK(std::holds_alternative<ldb::field_not_found>(query.search_via_field(1, index)));
+}
+
+TEST_CASE("store retrieves tuples with a template_tuple_query") {
+    ldb::store store;
+    store.out(lv::linda_tuple("key", 1, "one"));
+    store.out(lv::linda_tuple("key", 2, "two"));
+
+    const ldb::store::query_type formal_value = ldb::template_tuple_query<index_type>(lv::linda_tuple("key", 0, "two"), 0b10);
+    CHECK(store.rdp(formal_value) == lv::linda_tuple("key", 2, "two"));
+
+    const ldb::store::query_type formal_header = ldb::template_tuple_query<index_type>(lv::linda_tuple(std::string(), 1, std::string()), 0b101);
+    CHECK(store.inp(formal_header) == lv::linda_tuple("key", 1, "one"));
+    CHECK_FALSE(store.rdp(formal_header));
+}
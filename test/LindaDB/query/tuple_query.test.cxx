@@ -0,0 +1,129 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/query/tuple_query --
+ *   Tests for the type erased tuple_query.
+ */
+
+#include <concepts>
+#include <string>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <ldb/lv/linda_tuple.hxx>
+#include <ldb/query/concrete_tuple_query.hxx>
+#include <ldb/query/manual_fields_query.hxx>
+#include <ldb/query/match_type.hxx>
+#include <ldb/query/tuple_query.hxx>
+#include <ldb/store.hxx>
+
+using index_type = ldb::index::tree::avl2_tree<ldb::lv::linda_value, ldb::store::pointer_type>;
+using query_type = ldb::store::query_type;
+
+TEST_CASE("tuple_query is copyable and movable") {
+    STATIC_CHECK(std::copyable<query_type>);
+    STATIC_CHECK(std::movable<query_type>);
+}
+
+TEST_CASE("tuple_query stores small queries inline") {
+    int i{};
+    const query_type query = ldb::make_query(ldb::over_index<index_type>, "abc", 1, ldb::ref(&i));
+    CHECK(query.stored_inline());
+    CHECK(query_type(ldb::concrete_tuple_query<index_type>(ldb::lv::linda_tuple(1, 2))).stored_inline());
+}
+
+TEST_CASE("tuple_query stores large queries on the heap") {
+    int i{};
+    const query_type query = ldb::make_query(ldb::over_index<index_type>,
+                                             "a", "b", "c", "d", ldb::ref(&i));
+    CHECK_FALSE(query.stored_inline());
+
+    const auto copy = query;
+    CHECK_FALSE(copy.stored_inline());
+    CHECK(ldb::lv::linda_tuple("a", "b", "c", "d", 13) == copy);
+}
+
+TEST_CASE("tuple_query copies and moves keep matching") {
+    const query_type query = ldb::make_query(ldb::over_index<index_type>, 1, "abc");
+    const ldb::lv::linda_tuple tuple(1, "abc");
+
+    auto copy = query;
+    CHECK(tuple == copy);
+    auto moved = std::move(copy);
+    CHECK(tuple == moved);
+    copy = moved;
+    CHECK(tuple == copy);
+    moved = std::move(copy);
+    CHECK(tuple == moved);
+    CHECK(tuple == query);
+}
+
+TEST_CASE("store rdp benchmark", "[.][benchmark]") {
+    ldb::store store;
+    for (int i = 0; i < 1000; ++i) store.out(ldb::lv::linda_tuple(i, 2L, i));
+
+    BENCHMARK("rdp by the first field") {
+        int i{};
+        return store.rdp(500, 2L, ldb::ref(&i));
+    };
+}
+
+TEST_CASE("tuple_query matches a block of tuples at once") {
+    int i = -1;
+    const query_type query = ldb::make_query(ldb::over_index<index_type>, "key", ldb::ref(&i));
+    const ldb::lv::linda_tuple tuples[] = {
+           ldb::lv::linda_tuple("key", 1),
+           ldb::lv::linda_tuple("other", 2),
+           ldb::lv::linda_tuple("key", 3L),
+           ldb::lv::linda_tuple("key", 4),
+           ldb::lv::linda_tuple("key", 5),
+    };
+
+    CHECK(query.match_block(tuples, 0b11111) == 0b11001);
+    CHECK(query.match_block(tuples, 0b10110) == 0b10000);
+    CHECK(query.match_block(tuples, 0) == 0);
+    CHECK(i == -1);
+}
+
+TEST_CASE("store scan binds the formals of the first match only") {
+    ldb::store store;
+    for (int i = 0; i < 100; ++i) store.out(ldb::lv::linda_tuple(i % 3 == 0 ? "miss" : "hit", static_cast<long>(i), i % 10));
+
+    std::string str;
+    long l{};
+    // the first field of the query is not given, so the store scans its chunks
+    const auto res = store.rdp(ldb::ref(&str), ldb::ref(&l), 5);
+    REQUIRE(res.has_value());
+    CHECK(str == "hit");
+    CHECK(l == 5L);
+    CHECK(*res == ldb::lv::linda_tuple("hit", 5L, 5));
+}
@@ -35,13 +35,17 @@
  */
 
 
+#include <algorithm>
 #include <concepts>
 #include <latch>
 #include <mutex>
+#include <optional>
 #include <random>
+#include <string>
 #include <string_view>
 #include <thread>
 #include <tuple>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <ldb/lv/linda_tuple.hxx>
@@ -66,7 +70,7 @@ TEST_CASE("store can store and rdp by value a nonempty tuple") {
 TEST_CASE("store can store without signaling and rdp by value a nonempty tuple") {
     ldb::store store;
     auto tuple = lv::linda_tuple("asd", 2);
-    store.out_nosignal(tuple);
+    store.out_nosignal(ldb::data::tuple_id{1, 0}, tuple);
     auto ret = store.rdp("asd", 2);
     REQUIRE(ret.has_value());
     CHECK(*ret == tuple);
@@ -317,25 +321,103 @@ namespace {
     struct test_broadcaster {
         using await_type = ldb::null_awaiter;
         ldb::lv::linda_tuple expected;
+        std::optional<ldb::data::tuple_id>* inserted_id;
+        std::optional<ldb::data::tuple_id>* deleted_id;
     };
     [[nodiscard]] ldb::null_awaiter
-    broadcast_insert(test_broadcaster bcast, const lv::linda_tuple& value) {
+    broadcast_insert(test_broadcaster bcast, ldb::data::tuple_id id, const lv::linda_tuple& value) {
         CHECK(bcast.expected == value);
+        *bcast.inserted_id = id;
         return {};
     }
     [[nodiscard]] ldb::null_awaiter
-    broadcast_delete(test_broadcaster bcast, const lv::linda_tuple& value) {
-        CHECK(bcast.expected == value);
+    broadcast_delete(test_broadcaster bcast, ldb::data::tuple_id id) {
+        *bcast.deleted_id = id;
         return {};
     }
     static_assert(ldb::broadcaster<test_broadcaster>);
+
+    // replays what a store broadcasts onto a replica
+    struct replicating_broadcaster {
+        using await_type = ldb::null_awaiter;
+        ldb::store* replica;
+        std::vector<ldb::data::tuple_id>* inserted;
+    };
+    [[nodiscard]] ldb::null_awaiter
+    broadcast_insert(replicating_broadcaster bcast, ldb::data::tuple_id id, const lv::linda_tuple& value) {
+        bcast.inserted->push_back(id);
+        bcast.replica->out_nosignal(id, value);
+        return {};
+    }
+    [[nodiscard]] ldb::null_awaiter
+    broadcast_delete(replicating_broadcaster bcast, ldb::data::tuple_id id) {
+        bcast.replica->remove_nosignal(id);
+        return {};
+    }
+    static_assert(ldb::broadcaster<replicating_broadcaster>);
 }
 
-TEST_CASE("broadcaster is notified when inserting with signaling") {
+TEST_CASE("broadcaster is notified with the same id when inserting and deleting") {
     ldb::store store;
     const auto tuple = ldb::lv::linda_tuple(1, 2, 3);
-    store.set_broadcast(test_broadcaster{tuple});
+    std::optional<ldb::data::tuple_id> inserted_id;
+    std::optional<ldb::data::tuple_id> deleted_id;
+    store.set_broadcast(test_broadcaster{tuple, &inserted_id, &deleted_id});
     store.out(tuple);
+    REQUIRE(inserted_id.has_value());
+    CHECK_FALSE(deleted_id.has_value());
+
+    CHECK(store.inp(1, 2, 3) == tuple);
+    REQUIRE(deleted_id.has_value());
+    CHECK(*deleted_id == *inserted_id);
+}
+
+TEST_CASE("store names each inserted tuple with a new id of its origin") {
+    ldb::store replica;
+    std::vector<ldb::data::tuple_id> inserted;
+    ldb::store store;
+    store.set_origin(3);
+    store.set_broadcast(replicating_broadcaster{&replica, &inserted});
+    store.out(lv::linda_tuple("dup", 1));
+    store.out(lv::linda_tuple("dup", 1));
+
+    REQUIRE(inserted.size() == 2);
+    CHECK(inserted[0].origin == 3);
+    CHECK(inserted[1].origin == 3);
+    CHECK(inserted[0] != inserted[1]);
+}
+
+TEST_CASE("replica removes tuples by the id they were broadcast with") {
+    ldb::store replica;
+    std::vector<ldb::data::tuple_id> inserted;
+    ldb::store store;
+    store.set_broadcast(replicating_broadcaster{&replica, &inserted});
+    store.out(lv::linda_tuple("dup", 1));
+    store.out(lv::linda_tuple("dup", 1));
+
+    CHECK(store.inp("dup", 1).has_value());
+    CHECK(replica.inp("dup", 1).has_value());
+    CHECK_FALSE(replica.inp("dup", 1).has_value());
+}
+
+TEST_CASE("replica drops a tuple whose removal arrived first") {
+    ldb::store replica;
+    replica.remove_nosignal(ldb::data::tuple_id{1, 7});
+    replica.out_nosignal(ldb::data::tuple_id{1, 7}, lv::linda_tuple("late", 1));
+    CHECK_FALSE(replica.rdp("late", 1).has_value());
+
+    replica.out_nosignal(ldb::data::tuple_id{1, 8}, lv::linda_tuple("late", 1));
+    CHECK(replica.rdp("late", 1).has_value());
+}
+
+TEST_CASE("store removes tuples found by scanning from its indices") {
+    ldb::store store;
+    store.out(lv::linda_tuple("key", 1));
+    int value{};
+    std::string key;
+    CHECK(store.inp(ldb::ref(&key), ldb::ref(&value)).has_value());
+    CHECK_FALSE(store.rdp("key", 1).has_value());
+    CHECK_FALSE(store.rdp(ldb::ref(&key), 1).has_value());
 }
 
 TEST_CASE("serial reads/writes proceeds",
@@ -446,3 +528,52 @@ TEST_CASE("parallel reads/writes do not deadlock",
            std::jthread(gatherer, "gatherer3"),
     };
 }
+
+TEST_CASE("store drains a tuple-bag sharing its first field") {
+    constexpr const auto task_count = 500;
+    ldb::store store;
+    for (int i = 0; i < task_count; ++i) {
+        store.out(lv::linda_tuple("task", i));
+    }
+
+    CHECK(store.inp("task", 250) == lv::linda_tuple("task", 250));
+    CHECK(store.rdp("task", 250) == std::nullopt);
+
+    std::vector<int> taken;
+    int task{};
+    while (store.inp("task", ldb::ref(&task))) {
+        taken.push_back(task);
+    }
+    CHECK(taken.size() == task_count - 1);
+    std::ranges::sort(taken);
+    CHECK(std::ranges::adjacent_find(taken) == taken.end());
+    for (int i = 0; i < task_count; ++i) {
+        CHECK(store.rdp("task", i) == std::nullopt);
+    }
+}
+
+TEST_CASE("store matches symbol tags by symbol only") {
+    using namespace lv::literals;
+    ldb::store store;
+    store.out(lv::linda_tuple("task"_sym, 1));
+    store.out(lv::linda_tuple("task", 2));
+
+    int val{};
+    CHECK(store.rdp("task"_sym, ldb::ref(&val)) == lv::linda_tuple("task"_sym, 1));
+    CHECK(store.inp(lv::linda_symbol("task"), ldb::ref(&val)) == lv::linda_tuple("task"_sym, 1));
+    CHECK(store.inp("task"_sym, ldb::ref(&val)) == std::nullopt);
+    CHECK(store.inp("task", ldb::ref(&val)) == lv::linda_tuple("task", 2));
+}
+
+TEST_CASE("store scan skips tuples of other shapes") {
+    ldb::store store;
+    for (int i = 0; i < 100; ++i) {
+        store.out(lv::linda_tuple(i, "noise", i));
+    }
+    store.out(lv::linda_tuple(7, 7L, 7));
+
+    long val{};
+    CHECK(store.rdp(ldb::ref(&val), 7L, 7) == std::nullopt);
+    CHECK(store.rdp(7, ldb::ref(&val), 7) == lv::linda_tuple(7, 7L, 7));
+    CHECK(val == 7L);
+}
@@ -35,11 +35,14 @@
  */
 
 
+#include <algorithm>
 #include <iostream>
+#include <numeric>
 #include <random>
 #include <string>
 #include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <ldb/index/tree/impl/avl2/avl2_tree.hxx>
 #include <ldb/lv/linda_tuple.hxx>
@@ -316,3 +319,45 @@ TEST_CASE("new chime AVL-tree can remove elements indefinitely",
     }
     SUCCEED();
 }
+
+TEST_CASE("chime AVL-tree churn benchmark",
+          "[.benchmark]") {
+    using churn_type = ldb::index::tree::avl2_tree<ldb::lv::linda_value, int>;
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> key(0, 99'999);
+    std::vector<int> keys(10'000);
+    std::ranges::generate(keys, [&rng, &key]() { return key(rng); });
+
+    BENCHMARK("insert then remove 10k random keys") {
+        churn_type sut;
+        for (int i = 0; const auto k : keys) {
+            sut.insert(ldb::lv::linda_value(k), i++);
+        }
+        int removed = 0;
+        for (const auto k : keys) {
+            if (sut.remove(lit::any_value_lookup(ldb::lv::linda_value(k)))) ++removed;
+        }
+        return removed;
+    };
+}
+
+TEST_CASE("chime AVL-tree duplicate key benchmark",
+          "[.benchmark]") {
+    using bag_type = ldb::index::tree::avl2_tree<ldb::lv::linda_value, int>;
+    std::vector<int> handles(10'000);
+    std::iota(handles.begin(), handles.end(), 0);
+    std::ranges::shuffle(handles, std::mt19937_64(42));
+    const ldb::lv::linda_value task("task");
+
+    BENCHMARK("insert then remove 10k handles of one key") {
+        bag_type sut;
+        for (const auto h : handles) {
+            sut.insert(task, h);
+        }
+        int removed = 0;
+        for (const auto h : handles) {
+            if (sut.remove(lit::value_lookup(task, h))) ++removed;
+        }
+        return removed;
+    };
+}
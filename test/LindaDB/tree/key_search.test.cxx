@@ -0,0 +1,133 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/tree/key_search --
+ *   Tests for the in-node key search of the index trees.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <ldb/index/tree/key_search.hxx>
+
+namespace lit = ldb::index::tree;
+
+TEMPLATE_TEST_CASE("key_lower_bound agrees with std::lower_bound on integral keys",
+                   "[key_search]",
+                   std::int16_t,
+                   std::uint16_t,
+                   std::int32_t,
+                   std::uint32_t,
+                   std::int64_t,
+                   std::uint64_t) {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<TestType> key_dist(std::numeric_limits<TestType>::min(),
+                                                     std::numeric_limits<TestType>::max());
+    for (std::size_t size = 0; size < 70; ++size) {
+        std::vector<TestType> keys(size);
+        std::ranges::generate(keys, [&] { return key_dist(rng); });
+        std::ranges::sort(keys);
+
+        std::vector<TestType> needles{std::numeric_limits<TestType>::min(),
+                                      std::numeric_limits<TestType>::max(),
+                                      TestType{0},
+                                      key_dist(rng)};
+        needles.insert(needles.end(), keys.begin(), keys.end());
+        for (const auto needle : needles) {
+            const auto expected = std::ranges::lower_bound(keys, needle) - keys.begin();
+            CHECK(lit::key_lower_bound(std::span<const TestType>(keys), needle)
+                  == static_cast<std::size_t>(expected));
+        }
+    }
+}
+
+TEST_CASE("key_lower_bound finds the first of duplicate keys") {
+    const std::vector<int> keys{1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3};
+    CHECK(lit::key_lower_bound(std::span<const int>(keys), 2) == 1);
+}
+
+TEST_CASE("key_lower_bound works for non-integral keys") {
+    const std::vector<std::string> keys{"a", "c", "e"};
+    CHECK(lit::key_lower_bound(std::span<const std::string>(keys), std::string("d")) == 2);
+    CHECK(lit::key_lower_bound(std::span<const std::string>(keys), std::string("f")) == 3);
+}
+
+namespace {
+    using packed_variant = std::variant<std::string, std::int32_t, std::uint64_t>;
+}
+
+TEST_CASE("packed_keys agrees with std::lower_bound on keys of one integral alternative") {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<std::uint64_t> key_dist;
+    for (std::size_t size = 1; size <= 16; ++size) {
+        std::vector<packed_variant> keys(size);
+        std::ranges::generate(keys, [&] { return packed_variant(key_dist(rng)); });
+        std::ranges::sort(keys);
+        lit::packed_keys<packed_variant, 16> packed;
+        packed.repack(keys);
+
+        std::vector<packed_variant> needles{packed_variant(std::uint64_t{0}),
+                                            packed_variant(std::numeric_limits<std::uint64_t>::max()),
+                                            packed_variant(key_dist(rng))};
+        needles.insert(needles.end(), keys.begin(), keys.end());
+        for (const auto& needle : needles) {
+            const auto expected = std::ranges::lower_bound(keys, needle) - keys.begin();
+            CHECK(packed.lower_bound(needle, size) == static_cast<std::size_t>(expected));
+        }
+    }
+}
+
+TEST_CASE("packed_keys places keys of other alternatives around the packed ones") {
+    const std::vector<packed_variant> keys{packed_variant(std::int32_t{-3}), packed_variant(std::int32_t{7})};
+    lit::packed_keys<packed_variant, 4> packed;
+    packed.repack(keys);
+    CHECK(packed.lower_bound(packed_variant(std::int32_t{0}), keys.size()) == 1);
+    CHECK(packed.lower_bound(packed_variant(std::string("a")), keys.size()) == 0);
+    CHECK(packed.lower_bound(packed_variant(std::uint64_t{0}), keys.size()) == 2);
+}
+
+TEST_CASE("packed_keys does not pack mixed or non-integral keys") {
+    lit::packed_keys<packed_variant, 4> packed;
+    packed.repack(std::vector<packed_variant>{packed_variant(std::int32_t{1}), packed_variant(std::uint64_t{1})});
+    CHECK_FALSE(packed.lower_bound(packed_variant(std::int32_t{1}), 2).has_value());
+    packed.repack(std::vector<packed_variant>{packed_variant(std::string("a"))});
+    CHECK_FALSE(packed.lower_bound(packed_variant(std::string("a")), 1).has_value());
+    packed.repack(std::vector<packed_variant>{});
+    CHECK_FALSE(packed.lower_bound(packed_variant(std::int32_t{1}), 0).has_value());
+}
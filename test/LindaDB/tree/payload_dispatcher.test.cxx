@@ -0,0 +1,80 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/tree/payload_dispatcher --
+ *   Tests for the payload_dispatcher's choice of clustering factor.
+ */
+
+#include <compare>
+#include <cstddef>
+#include <type_traits>
+
+#include <catch2/catch_test_macros.hpp>
+#include <ldb/index/tree/payload_dispatcher.hxx>
+
+namespace lit = ldb::index::tree;
+namespace lps = lit::payloads;
+
+namespace {
+    struct tuned_key {
+        int value;
+
+        friend auto
+        operator<=>(const tuned_key&, const tuned_key&) = default;
+    };
+}
+
+template<>
+struct lit::tuned_clustering<tuned_key, int> : std::integral_constant<std::size_t, 5> { };
+
+TEST_CASE("payload_dispatcher uses the heuristic without a tuned clustering") {
+    using heuristic = lps::chime_payload<int,
+                                         int,
+                                         lit::cluster_for_minimized_overhead_effect(
+                                                sizeof(int) + sizeof(lps::chime_value_storage<int>),
+                                                lit::payload_dispatcher<int, int>::overhead_size,
+                                                0)>;
+    STATIC_CHECK(lit::tuned_clustering_v<int, int> == 0);
+    STATIC_CHECK(std::is_same_v<lit::payload_dispatcher<int, int>::type, heuristic>);
+}
+
+TEST_CASE("payload_dispatcher uses the tuned clustering if present") {
+    STATIC_CHECK(std::is_same_v<lit::payload_dispatcher<tuned_key, int>::type,
+                                lps::chime_payload<tuned_key, int, 5>>);
+}
+
+TEST_CASE("payload_dispatcher prefers the requested clustering to the tuned one") {
+    STATIC_CHECK(std::is_same_v<lit::payload_dispatcher<tuned_key, int, 3>::type,
+                                lps::chime_payload<tuned_key, int, 3>>);
+    STATIC_CHECK(std::is_same_v<lit::payload_dispatcher<tuned_key, int, 1>::type,
+                                lps::scalar_payload<tuned_key, int>>);
+}
@@ -35,14 +35,19 @@
  */
 
 
+#include <algorithm>
+#include <numeric>
+#include <random>
 #include <sstream>
 #include <tuple>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <ldb/index/tree/index_query.hxx>
 #include <ldb/index/tree/payload.hxx>
 #include <ldb/index/tree/payload/chime_payload.hxx>
 #include <ldb/lv/linda_tuple.hxx>
+#include <ldb/lv/linda_value.hxx>
 
 #include "ldb/query/manual_fields_query.hxx"
 #include "ldb/query/match_type.hxx"
@@ -376,3 +381,152 @@ TEST_CASE("chime_payload removes correct element") {
     REQUIRE(res.has_value());
     CHECK(*res == &buf[2]);
 }
+
+TEST_CASE("chime_payload merges disjoint payload in order") {
+    sut_type<4> sut(2, Test_Value);
+    std::ignore = sut.try_set(6, Test_Value);
+    sut_type<4> other(4, Test_Value);
+    std::ignore = other.try_set(8, Test_Value);
+
+    REQUIRE(sut.try_merge(other));
+    CHECK(other.empty());
+    std::ostringstream ss;
+    ss << sut;
+    CHECK(ss.str() == R"__((4 4 (2 (42)) (4 (42)) (6 (42)) (8 (42))))__");
+}
+
+TEST_CASE("chime_payload merge joins the value sets of equal keys") {
+    sut_type<4> sut(2, Test_Value);
+    std::ignore = sut.try_set(6, Test_Value);
+    sut_type<4> other(6, Test_Value + 1);
+    std::ignore = other.try_set(9, Test_Value);
+
+    REQUIRE(sut.try_merge(other));
+    CHECK(other.empty());
+    std::ostringstream ss;
+    ss << sut;
+    CHECK(ss.str() == R"__((4 3 (2 (42)) (6 (42 43)) (9 (42))))__");
+}
+
+TEST_CASE("chime_payload merge keeps its keys in place when other only has duplicates") {
+    sut_type<4> sut(1, Test_Value);
+    std::ignore = sut.try_set(5, Test_Value);
+    sut_type<4> other(1, Test_Value + 1);
+
+    REQUIRE(sut.try_merge(other));
+    CHECK(other.empty());
+    std::ostringstream ss;
+    ss << sut;
+    CHECK(ss.str() == R"__((4 2 (1 (42 43)) (5 (42))))__");
+}
+
+TEST_CASE("chime_payload does not merge payload it cannot fit") {
+    sut_type<2> sut(2, Test_Value);
+    sut_type<2> other(4, Test_Value);
+    std::ignore = other.try_set(8, Test_Value);
+
+    CHECK_FALSE(sut.try_merge(other));
+    CHECK(sut.size() == 1);
+    CHECK(other.size() == 2);
+}
+
+TEST_CASE("chime_payload merge_until_full takes the greatest keys of other") {
+    sut_type<3> sut(10, Test_Value);
+    sut_type<3> other(1, Test_Value);
+    std::ignore = other.try_set(2, Test_Value);
+    std::ignore = other.try_set(3, Test_Value);
+
+    sut.merge_until_full(other);
+    CHECK(sut.full());
+    std::ostringstream ss;
+    ss << sut << " " << other;
+    CHECK(ss.str() == R"__((3 3 (2 (42)) (3 (42)) (10 (42))) (3 1 (1 (42))))__");
+}
+
+TEST_CASE("chime_payload merge_until_full merges equal keys without space") {
+    sut_type<2> sut(3, Test_Value);
+    sut_type<2> other(1, Test_Value);
+    std::ignore = other.try_set(3, Test_Value + 1);
+
+    sut.merge_until_full(other);
+    std::ostringstream ss;
+    ss << sut << " " << other;
+    CHECK(ss.str() == R"__((2 2 (1 (42)) (3 (42 43))) (2 0))__");
+}
+
+TEST_CASE("chime_payload removes values of a heavily duplicated key by handle") {
+    constexpr const auto value_count = static_cast<int>(lps::chime_pool_threshold) * 3;
+    sut_type<2> sut(Test_Key, 0);
+    for (int i = 1; i < value_count; ++i) {
+        std::ignore = sut.try_set(Test_Key, i);
+    }
+
+    std::vector<int> handles(value_count);
+    std::iota(handles.begin(), handles.end(), 0);
+    std::ranges::shuffle(handles, std::mt19937(42));
+    for (const auto handle : handles) {
+        CHECK(sut.try_get(lit::value_lookup(Test_Key, handle)) == std::optional{handle});
+        CHECK(sut.remove(lit::value_lookup(Test_Key, handle)) == std::optional{handle});
+        CHECK(sut.try_get(lit::value_lookup(Test_Key, handle)) == std::nullopt);
+    }
+    CHECK(sut.empty());
+}
+
+TEST_CASE("chime_payload pops any value of a heavily duplicated key") {
+    constexpr const auto value_count = static_cast<int>(lps::chime_pool_threshold) * 3;
+    sut_type<2> sut(Test_Key, 0);
+    for (int i = 1; i < value_count; ++i) {
+        std::ignore = sut.try_set(Test_Key, i);
+    }
+
+    std::vector<int> popped;
+    while (auto val = sut.remove(lit::any_value_lookup(Test_Key))) {
+        popped.push_back(*val);
+    }
+    std::ranges::sort(popped);
+    std::vector<int> expected(value_count);
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(popped == expected);
+    CHECK(sut.empty());
+}
+
+TEST_CASE("chime_payload keeps duplicate handles of a pooled key apart") {
+    constexpr const auto value_count = static_cast<int>(lps::chime_pool_threshold) * 2;
+    sut_type<2> sut(Test_Key, 0);
+    for (int i = 1; i < value_count; ++i) {
+        std::ignore = sut.try_set(Test_Key, i % 4);
+    }
+
+    for (int i = 0; i < value_count; ++i) {
+        CHECK(sut.remove(lit::value_lookup(Test_Key, i % 4)) == std::optional{i % 4});
+    }
+    CHECK(sut.empty());
+}
+
+TEST_CASE("chime_payload finds linda_value keys of one or of mixed alternatives") {
+    using lv_sut_type = lps::chime_payload<ldb::lv::linda_value, int, 8>;
+    const auto check_keys = [](const std::vector<ldb::lv::linda_value>& keys) {
+        lv_sut_type sut(keys.front(), 0);
+        for (int i = 1; i < static_cast<int>(keys.size()); ++i) {
+            REQUIRE(sut.try_set(keys[static_cast<std::size_t>(i)], i));
+        }
+        for (int i = 0; i < static_cast<int>(keys.size()); ++i) {
+            CHECK(sut.try_get(lit::value_lookup(keys[static_cast<std::size_t>(i)], i)) == std::optional{i});
+        }
+        CHECK(sut.try_get(lit::value_lookup(ldb::lv::linda_value(std::int64_t{1}), 0)) == std::nullopt);
+        for (int i = 0; i < static_cast<int>(keys.size()); ++i) {
+            CHECK(sut.remove(lit::value_lookup(keys[static_cast<std::size_t>(i)], i)) == std::optional{i});
+        }
+        CHECK(sut.empty());
+    };
+
+    std::vector<ldb::lv::linda_value> keys;
+    for (const int key : {17, -4, 9000, 3, -70000, 42, 0, 5}) keys.emplace_back(key);
+    check_keys(keys);
+    std::ranges::shuffle(keys, std::mt19937(42));
+    check_keys(keys);
+
+    keys[2] = ldb::lv::linda_value(2.5);
+    keys[5] = ldb::lv::linda_value(std::uint64_t{3});
+    check_keys(keys);
+}
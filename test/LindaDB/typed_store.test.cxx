@@ -0,0 +1,196 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/LindaDB/typed_store --
+ *   Tests for the typed_store tuple space of compile-time known tuple shapes.
+ */
+
+#include <concepts>
+#include <optional>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#include <catch2/catch_test_macros.hpp>
+#include <ldb/lv/linda_tuple.hxx>
+#include <ldb/query/match_type.hxx>
+#include <ldb/typed_store.hxx>
+
+namespace lv = ldb::lv;
+using namespace std::literals;
+
+using int_store = ldb::typed_store<int, long, std::string>;
+
+TEST_CASE("typed_store is default constructible") {
+    STATIC_CHECK(std::constructible_from<int_store>);
+}
+
+TEST_CASE("typed_store can out and rdp by value a row") {
+    int_store store;
+    store.out({1, 2L, "test"s});
+    const auto res = store.rdp(1, 2L, "test"s);
+    REQUIRE(res.has_value());
+    CHECK(*res == std::tuple(1, 2L, "test"s));
+    CHECK(store.size() == 1);
+}
+
+TEST_CASE("typed_store rdp binds formals of a template") {
+    int_store store;
+    store.out({1, 2L, "test"s});
+    std::string str;
+    long l{};
+    const auto res = store.rdp(1, ldb::ref(&l), ldb::ref(&str));
+    REQUIRE(res.has_value());
+    CHECK(l == 2L);
+    CHECK(str == "test");
+}
+
+TEST_CASE("typed_store rdp without indexed values scans the columns") {
+    int_store store;
+    for (int i = 0; i < 1000; ++i) {
+        store.out({i, static_cast<long>(i % 7), std::to_string(i)});
+    }
+    int i{};
+    long l{};
+    const auto res = store.rdp(ldb::ref(&i), ldb::ref(&l), "713"s);
+    REQUIRE(res.has_value());
+    CHECK(i == 713);
+    CHECK(l == 713 % 7);
+    CHECK_FALSE(store.rdp(ldb::ref(&i), ldb::ref(&l), "1000"s).has_value());
+}
+
+TEST_CASE("typed_store rdp through an index checks the other fields") {
+    int_store store;
+    store.out({1, 2L, "a"s});
+    store.out({1, 3L, "b"s});
+    std::string str;
+    const auto res = store.rdp(1, 3L, ldb::ref(&str));
+    REQUIRE(res.has_value());
+    CHECK(str == "b");
+    CHECK_FALSE(store.rdp(1, 4L, ldb::ref(&str)).has_value());
+}
+
+TEST_CASE("typed_store inp removes only the first match") {
+    int_store store;
+    store.out({1, 2L, "test"s});
+    CHECK(store.inp(1, 2L, "test"s).has_value());
+    CHECK_FALSE(store.inp(1, 2L, "test"s).has_value());
+    CHECK(store.size() == 0);
+}
+
+TEST_CASE("typed_store reuses the rows of removed tuples") {
+    int_store store;
+    for (int i = 0; i < 600; ++i) store.out({i, 0L, ""s});
+    for (int i = 0; i < 600; i += 2) REQUIRE(store.inp(i, 0L, ""s).has_value());
+    for (int i = 0; i < 300; ++i) store.out({-i, 1L, "again"s});
+
+    CHECK(store.size() == 600);
+    for (int i = 1; i < 600; i += 2) CHECK(store.rdp(i, 0L, ""s).has_value());
+    for (int i = 0; i < 300; ++i) CHECK(store.rdp(-i, 1L, "again"s).has_value());
+}
+
+TEST_CASE("typed_store in waits for a matching out") {
+    int_store store;
+    long l{};
+    std::thread writer([&store] {
+        std::this_thread::sleep_for(10ms);
+        store.out({1, 42L, "late"s});
+    });
+    const auto res = store.in(1, ldb::ref(&l), "late"s);
+    writer.join();
+    CHECK(l == 42L);
+    CHECK(res == std::tuple(1, 42L, "late"s));
+    CHECK(store.size() == 0);
+}
+
+TEST_CASE("typed_store rows round-trip through linda_tuples") {
+    const auto row = int_store::row_type(1, 2L, "test"s);
+    const auto tuple = int_store::to_linda_tuple(row);
+    CHECK(tuple == lv::linda_tuple(1, 2L, "test"));
+    CHECK(int_store::from_linda_tuple(tuple) == row);
+    CHECK_FALSE(int_store::from_linda_tuple(lv::linda_tuple(1, 2, "test")).has_value());
+    CHECK_FALSE(int_store::from_linda_tuple(lv::linda_tuple(1, 2L)).has_value());
+}
+
+TEST_CASE("typed_store applies removals received before their tuple") {
+    int_store store;
+    store.remove_nosignal(ldb::data::tuple_id{1, 0});
+    store.out_nosignal(ldb::data::tuple_id{1, 0}, lv::linda_tuple(1, 2L, "test"));
+    CHECK(store.size() == 0);
+    store.out_nosignal(ldb::data::tuple_id{1, 1}, lv::linda_tuple(1, 2L, "test"));
+    CHECK(store.size() == 1);
+    store.remove_nosignal(ldb::data::tuple_id{1, 1});
+    CHECK(store.size() == 0);
+}
+
+TEST_CASE("typed_store removes the exact tuple an id names") {
+    int_store store;
+    store.out_nosignal(ldb::data::tuple_id{1, 0}, lv::linda_tuple(1, 2L, "first"));
+    store.out_nosignal(ldb::data::tuple_id{2, 0}, lv::linda_tuple(1, 2L, "second"));
+    store.out_nosignal(ldb::data::tuple_id{2, 1}, lv::linda_tuple("other", "shape"));
+    store.remove_nosignal(ldb::data::tuple_id{2, 1});
+    store.remove_nosignal(ldb::data::tuple_id{2, 0});
+    CHECK(store.size() == 1);
+    CHECK(store.rdp(1, 2L, "first"s).has_value());
+}
+
+namespace {
+    struct test_broadcaster {
+        using await_type = ldb::null_awaiter;
+        int* inserts;
+        int* deletes;
+    };
+
+    ldb::null_awaiter
+    broadcast_insert(test_broadcaster bcast, ldb::data::tuple_id, const lv::linda_tuple& value) {
+        CHECK(value == lv::linda_tuple(1, 2L, "test"));
+        ++*bcast.inserts;
+        return {};
+    }
+    ldb::null_awaiter
+    broadcast_delete(test_broadcaster bcast, ldb::data::tuple_id) {
+        ++*bcast.deletes;
+        return {};
+    }
+    static_assert(ldb::broadcaster<test_broadcaster>);
+}
+
+TEST_CASE("typed_store broadcasts rows as linda_tuples") {
+    int inserts = 0;
+    int deletes = 0;
+    int_store store;
+    store.set_broadcast(test_broadcaster{&inserts, &deletes});
+    store.out({1, 2L, "test"s});
+    CHECK(store.inp(1, 2L, "test"s).has_value());
+    CHECK(inserts == 1);
+    CHECK(deletes == 1);
+}
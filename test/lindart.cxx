@@ -37,38 +37,68 @@
 #include <exception>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <syncstream>
 
 #include <ldb/lv/linda_tuple.hxx>
 #include <ldb/query/match_type.hxx>
 #include <lrt/runtime.hxx>
 
-#include <mpi.h>
-
 int
 main(int argc, char** argv) try {
-    lrt::runtime rt(&argc, &argv);
-    auto& store = rt.store();
+    auto mode = lrt::distribution::replicated;
+    auto threading = lrt::mpi_threading::multiple;
+    lrt::receive_options options{};
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--partitioned") mode = lrt::distribution::partitioned;
+        if (std::string_view(argv[i]) == "--node-shared") mode = lrt::distribution::node_shared;
+        if (std::string_view(argv[i]) == "--funneled") threading = lrt::mpi_threading::funneled;
+        if (std::string_view(argv[i]) == "--one-sided") options.one_sided = true;
+        if (std::string_view(argv[i]) == "--inline-apply") options.apply_workers = 0;
+        if (std::string_view(argv[i]) == "--trace") options.trace = true;
+    }
+    lrt::runtime rt(&argc, &argv, mode, options, threading);
 
-    int rank, size;
+    const auto rank = rt.rank();
+    const auto size = rt.size();
     std::string data;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    MPI_Comm_size(MPI_COMM_WORLD, &size);
 
     if (rank == 0) {
         for (int i = 2; i <= size; ++i) {
-            auto red = store.in("rank", i, ldb::ref(&data));
+            auto red = rt.in("rank", i, ldb::ref(&data));
             std::osyncstream(std::cout) << "rank0: " << red << " from " << i << "\n"
                                         << std::flush;
         }
+
+        // larger than a posted receive buffer: announced, then received on its own
+        std::string large;
+        rt.in("large", ldb::ref(&large));
+        std::osyncstream(std::cout) << "rank0: large tuple of " << large.size() << " bytes\n"
+                                    << std::flush;
+        if (large != std::string(100'000, 'x')) return 1;
+
+        // a formal header has no single owner, so this one has to look everywhere
+        std::string header;
+        int from{};
+        for (int i = 2; i <= size; ++i) {
+            auto red = rt.in(ldb::ref(&header), ldb::ref(&from), "done");
+            std::osyncstream(std::cout) << "rank0: " << red << " as " << header << "\n"
+                                        << std::flush;
+        }
+
+        // every other rank is already blocked reading this
+        rt.out(ldb::lv::linda_tuple{"go"});
     }
     else {
         data = "Hello World!";
         ldb::lv::linda_tuple const tuple{"rank", rank + 1, data};
-        store.out(tuple);
+        rt.out(tuple);
+        if (rank == 1) rt.out(ldb::lv::linda_tuple{"large", std::string(100'000, 'x')});
+        rt.out(ldb::lv::linda_tuple{"finished-" + std::to_string(rank), rank, "done"});
+        rt.rd("go");
         std::osyncstream(std::cout) << "rank" << rank << ": finishing\n"
                                     << std::flush;
     }
 } catch (const std::exception& ex) {
     std::cerr << "fatal: uncaught exception: " << ex.what() << "\n\n";
-}
\ No newline at end of file
+}
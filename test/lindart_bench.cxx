@@ -0,0 +1,95 @@
+/* LindaDB project
+ *
+ * Copyright (c) 2026 András Bodor <bodand@pm.me>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Originally created: 2026-10-18.
+ *
+ * test/lindart_bench --
+ *   Throughput of small tuples through the runtime: every rank but the first
+ *   puts tuples in the space, and the first one takes all of them out.
+ *   Usage: lindart-bench [tuples per rank] [--partitioned | --node-shared] [--funneled] [--one-sided]
+ *                        [--inline-apply]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string_view>
+#include <syncstream>
+
+#include <ldb/lv/linda_tuple.hxx>
+#include <ldb/query/match_type.hxx>
+#include <lrt/runtime.hxx>
+
+int
+main(int argc, char** argv) try {
+    int count = 2'000;
+    auto mode = lrt::distribution::replicated;
+    auto threading = lrt::mpi_threading::multiple;
+    lrt::receive_options options{};
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--partitioned") mode = lrt::distribution::partitioned;
+        else if (std::string_view(argv[i]) == "--node-shared") mode = lrt::distribution::node_shared;
+        else if (std::string_view(argv[i]) == "--funneled") threading = lrt::mpi_threading::funneled;
+        else if (std::string_view(argv[i]) == "--one-sided") options.one_sided = true;
+        else if (std::string_view(argv[i]) == "--inline-apply") options.apply_workers = 0;
+        else count = std::atoi(argv[i]);
+    }
+    lrt::runtime rt(&argc, &argv, mode, options, threading);
+
+    const auto rank = rt.rank();
+    const auto size = rt.size();
+
+    rt.barrier();
+    const auto start = std::chrono::steady_clock::now();
+    if (rank == 0) {
+        int from{};
+        int seq{};
+        for (int i = 0; i < count * (size - 1); ++i) {
+            rt.in("bench", ldb::ref(&from), ldb::ref(&seq));
+        }
+    }
+    else {
+        for (int i = 0; i < count; ++i) {
+            rt.out(ldb::lv::linda_tuple{"bench", rank, i});
+        }
+    }
+    rt.barrier();
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    if (rank == 0) {
+        const auto tuples = count * (size - 1);
+        std::osyncstream(std::cerr) << "lindart-bench: " << tuples << " tuples over " << size << " ranks in "
+                                    << elapsed.count() << " s: " << tuples / elapsed.count() << " tuples/s\n";
+    }
+} catch (const std::exception& ex) {
+    std::cerr << "fatal: uncaught exception: " << ex.what() << "\n\n";
+    return 1;
+}